@@ -3,7 +3,7 @@ from __future__ import annotations
 from typing import TYPE_CHECKING, Callable, Generator, Optional
 from warnings import warn
 
-from pyvrp._pyvrp import PopulationParams, SubPopulation
+from pyvrp._pyvrp import PopulationParams, SubPopulation, select_parents
 from pyvrp.exceptions import EmptySolutionWarning
 
 if TYPE_CHECKING:
@@ -98,6 +98,8 @@ class Population:
         """
         Adds the given solution to the population. Survivor selection is
         automatically triggered when the population reaches its maximum size.
+        The solution is not added when the population already contains an
+        equal solution.
 
         Parameters
         ----------
@@ -160,21 +162,7 @@ class Population:
             A solution pair (parents).
         """
         self._update_fitness(cost_evaluator)
-
-        first = self._get_tournament(rng, k)
-        second = self._get_tournament(rng, k)
-
-        diversity = self._op(first, second)
-        lb = self._params.lb_diversity
-        ub = self._params.ub_diversity
-
-        tries = 1
-        while not (lb <= diversity <= ub) and tries <= 10:
-            tries += 1
-            second = self._get_tournament(rng, k)
-            diversity = self._op(first, second)
-
-        return first, second
+        return select_parents(self._feas, self._infeas, rng, k)
 
     def get_tournament(
         self,
@@ -11,11 +11,16 @@ from ._pyvrp import Client as Client
 from ._pyvrp import CostEvaluator as CostEvaluator
 from ._pyvrp import Depot as Depot
 from ._pyvrp import DynamicBitset as DynamicBitset
+from ._pyvrp import Metric as Metric
 from ._pyvrp import ProblemData as ProblemData
 from ._pyvrp import RandomNumberGenerator as RandomNumberGenerator
 from ._pyvrp import Route as Route
 from ._pyvrp import Solution as Solution
 from ._pyvrp import VehicleType as VehicleType
+from ._pyvrp import read_instance as read_instance
+from ._pyvrp import read_instance_file as read_instance_file
+from ._pyvrp import write_instance_file as write_instance_file
+from ._pyvrp import write_matrix as write_matrix
 from .read import read as read
 from .read import read_solution as read_solution
 from .show_versions import show_versions as show_versions
@@ -1,7 +1,10 @@
+import os
 from typing import Callable, Iterator, Optional, Union, overload
 
 import numpy as np
 
+MatrixLike = Union[np.ndarray[int], str, os.PathLike, Metric]
+
 class CostEvaluator:
     def __init__(
         self, capacity_penalty: int = 0, tw_penalty: int = 0
@@ -86,14 +89,28 @@ class VehicleType:
         name: str = "",
     ) -> None: ...
 
+class Metric:
+    def __init__(
+        self,
+        kind: str = "euclidean",
+        scale: float = 1.0,
+        degrees_per_unit: float = 1.0,
+    ) -> None: ...
+    @property
+    def kind(self) -> str: ...
+    @property
+    def scale(self) -> float: ...
+    @property
+    def degrees_per_unit(self) -> float: ...
+
 class ProblemData:
     def __init__(
         self,
         clients: list[Client],
         depots: list[Depot],
         vehicle_types: list[VehicleType],
-        distance_matrix: np.ndarray[int],
-        duration_matrix: np.ndarray[int],
+        distance_matrix: MatrixLike,
+        duration_matrix: MatrixLike,
     ) -> None: ...
     def location(self, idx: int) -> Union[Client, Depot]: ...
     def clients(self) -> list[Client]: ...
@@ -104,8 +121,8 @@ class ProblemData:
         clients: Optional[list[Client]] = None,
         depots: Optional[list[Depot]] = None,
         vehicle_types: Optional[list[VehicleType]] = None,
-        distance_matrix: Optional[np.ndarray[int]] = None,
-        duration_matrix: Optional[np.ndarray[int]] = None,
+        distance_matrix: Optional[MatrixLike] = None,
+        duration_matrix: Optional[MatrixLike] = None,
     ) -> ProblemData: ...
     def centroid(self) -> tuple[float, float]: ...
     def vehicle_type(self, vehicle_type: int) -> VehicleType: ...
@@ -123,6 +140,19 @@ class ProblemData:
     def num_vehicles(self) -> int: ...
     @property
     def num_vehicle_types(self) -> int: ...
+    @property
+    def has_time_windows(self) -> bool: ...
+    @property
+    def has_pickups(self) -> bool: ...
+    @property
+    def has_release_times(self) -> bool: ...
+    @property
+    def has_optional_clients(self) -> bool: ...
+    def to_bytes(self) -> bytes: ...
+    @staticmethod
+    def from_bytes(data: bytes) -> ProblemData: ...
+    def __getstate__(self) -> bytes: ...
+    def __setstate__(self, state: bytes, /) -> None: ...
 
 class Route:
     def __init__(
@@ -153,8 +183,11 @@ class Route:
     def centroid(self) -> tuple[float, float]: ...
     def vehicle_type(self) -> int: ...
     def depot(self) -> int: ...
-    def __getstate__(self) -> tuple: ...
-    def __setstate__(self, state: tuple, /) -> None: ...
+    def to_bytes(self) -> bytes: ...
+    @staticmethod
+    def from_bytes(data: bytes) -> Route: ...
+    def __getstate__(self) -> bytes: ...
+    def __setstate__(self, state: bytes, /) -> None: ...
 
 class Solution:
     def __init__(
@@ -185,8 +218,11 @@ class Solution:
     def __deepcopy__(self, memo: dict) -> Solution: ...
     def __hash__(self) -> int: ...
     def __eq__(self, other: object) -> bool: ...
-    def __getstate__(self) -> tuple: ...
-    def __setstate__(self, state: tuple, /) -> None: ...
+    def to_bytes(self) -> bytes: ...
+    @staticmethod
+    def from_bytes(data: bytes) -> Solution: ...
+    def __getstate__(self) -> bytes: ...
+    def __setstate__(self, state: bytes, /) -> None: ...
 
 class PopulationParams:
     generation_size: int
@@ -194,6 +230,8 @@ class PopulationParams:
     min_pop_size: int
     nb_close: int
     nb_elite: int
+    num_threads: int
+    parallel_threshold: int
     ub_diversity: float
     def __init__(
         self,
@@ -203,6 +241,8 @@ class PopulationParams:
         nb_close: int = 5,
         lb_diversity: float = 0.1,
         ub_diversity: float = 0.5,
+        num_threads: int = 0,
+        parallel_threshold: int = 500_000,
     ) -> None: ...
     @property
     def max_pop_size(self) -> int: ...
@@ -222,6 +262,32 @@ class SubPopulation:
     def __iter__(self) -> Iterator[SubPopulationItem]: ...
     def __len__(self) -> int: ...
 
+def select_parents(
+    feasible: SubPopulation,
+    infeasible: SubPopulation,
+    rng: RandomNumberGenerator,
+    k: int = 2,
+) -> tuple[Solution, Solution]: ...
+def write_matrix(
+    path: Union[str, os.PathLike], matrix: np.ndarray[int]
+) -> None: ...
+
+class UnsupportedInstanceError(ValueError): ...
+
+def read_instance(
+    path: Union[str, os.PathLike],
+    instance_format: str = "vrplib",
+    round_func: str = "none",
+) -> ProblemData: ...
+def write_instance_file(
+    path: Union[str, os.PathLike],
+    data: ProblemData,
+    neighbours: Optional[list[list[int]]] = None,
+) -> None: ...
+def read_instance_file(
+    path: Union[str, os.PathLike],
+) -> tuple[ProblemData, Optional[list[list[int]]]]: ...
+
 class SubPopulationItem:
     @property
     def fitness(self) -> float: ...
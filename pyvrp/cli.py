@@ -1,4 +1,5 @@
 import argparse
+import hashlib
 from functools import partial
 from pathlib import Path
 from typing import Optional
@@ -25,6 +26,8 @@ from pyvrp import (
     RandomNumberGenerator,
     Result,
     Solution,
+    read_instance_file,
+    write_instance_file,
 )
 from pyvrp.crossover import selective_route_exchange as srex
 from pyvrp.diversity import broken_pairs_distance as bpd
@@ -92,6 +95,80 @@ def write_solution(where: Path, data: ProblemData, result: Result):
         fh.write(f"Cost: {round(result.cost(), 2)}\n")
 
 
+def load_instance(
+    data_loc: Path,
+    instance_format: str,
+    round_func: str,
+    nb_params: NeighbourhoodParams,
+    cache_dir: Optional[Path] = None,
+) -> tuple[ProblemData, list[list[int]]]:
+    """
+    Reads the instance at the given location, and computes its neighbourhood.
+    When a cache directory is given, both are stored there in PyVRP's binary
+    instance format, and loaded from there again on subsequent calls, as long
+    as the instance file has not been changed in the meantime.
+
+    Parameters
+    ----------
+    data_loc
+        Filesystem location of the VRPLIB instance.
+    instance_format
+        Data format of the filesystem instance. Argument is passed to
+        ``read()``.
+    round_func
+        Rounding function to use for rounding non-integral data. Argument is
+        passed to ``read()``.
+    nb_params
+        Neighbourhood parameters to compute the neighbourhood with.
+    cache_dir
+        Optional directory to cache the instance and its neighbourhood in.
+
+    Returns
+    -------
+    tuple[ProblemData, list[list[int]]]
+        The instance, and its neighbourhood.
+    """
+    if not cache_dir:
+        data = read(data_loc, instance_format, round_func)
+        return data, compute_neighbours(data, nb_params)
+
+    # The cached file depends on which instance file was read, and on its
+    # contents, which we identify by the file's size and modification time.
+    # It also depends on how the instance was read and how its neighbourhood
+    # was computed, so all of these are part of the file name. Instances with
+    # the same name in different directories then do not share cache files.
+    stat = data_loc.stat()
+    key = (
+        str(data_loc.resolve()),
+        stat.st_size,
+        stat.st_mtime_ns,
+        instance_format,
+        round_func,
+        nb_params,
+    )
+
+    digest = hashlib.sha256(repr(key).encode()).hexdigest()[:10]
+    cache_loc = cache_dir / f"{data_loc.stem}-{digest}.pyvrp"
+
+    if cache_loc.exists():
+        try:
+            data, neighbours = read_instance_file(cache_loc)
+            if neighbours is not None:
+                return data, neighbours
+        except ValueError:  # e.g. corrupt, or written by another version
+            pass
+
+    data = read(data_loc, instance_format, round_func)
+    neighbours = compute_neighbours(data, nb_params)
+
+    # Cache files are replaced only once they are written completely, so
+    # other processes never read a partially written cache file.
+    cache_dir.mkdir(parents=True, exist_ok=True)
+    write_instance_file(cache_loc, data, neighbours)
+
+    return data, neighbours
+
+
 def solve(
     data_loc: Path,
     instance_format: str,
@@ -102,6 +179,7 @@ def solve(
     no_improvement: Optional[int],
     stats_dir: Optional[Path],
     sol_dir: Optional[Path],
+    cache_dir: Optional[Path] = None,
     **kwargs,
 ) -> tuple[str, str, float, int, float]:
     """
@@ -129,6 +207,9 @@ def solve(
         The directory to write runtime statistics to.
     sol_dir
         The directory to write the best found solutions to.
+    cache_dir
+        The directory to cache instances and their neighbourhoods in. See
+        ``load_instance()``.
 
     Returns
     -------
@@ -147,12 +228,13 @@ def solve(
     pop_params = PopulationParams(**config.get("population", {}))
     nb_params = NeighbourhoodParams(**config.get("neighbourhood", {}))
 
-    data = read(data_loc, instance_format, round_func)
+    data, neighbours = load_instance(
+        data_loc, instance_format, round_func, nb_params, cache_dir
+    )
+
     rng = RandomNumberGenerator(seed=seed)
     pen_manager = PenaltyManager(pen_params)
     pop = Population(bpd, params=pop_params)
-
-    neighbours = compute_neighbours(data, nb_params)
     ls = LocalSearch(data, rng, neighbours)
 
     node_ops = NODE_OPERATORS
@@ -265,6 +347,13 @@ def main():
     """
     parser.add_argument("--sol_dir", type=Path, help=msg)
 
+    msg = """
+    Directory to cache instances in, in PyVRP's binary instance format (one
+    file per instance). Cached instances are loaded much faster than the
+    original instance files on subsequent runs.
+    """
+    parser.add_argument("--cache", dest="cache_dir", type=Path, help=msg)
+
     parser.add_argument(
         "--instance_format",
         default="vrplib",
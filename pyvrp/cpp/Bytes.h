@@ -0,0 +1,203 @@
+#ifndef PYVRP_BYTES_H
+#define PYVRP_BYTES_H
+
+#include "Measure.h"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace pyvrp
+{
+/**
+ * Binary format of a serialised object: a four character tag that identifies
+ * the type of the object, and the version of its layout.
+ */
+struct ByteFormat
+{
+    char tag[5];
+    uint32_t version;
+};
+
+// Each format is versioned separately. The version of a format should be
+// bumped whenever its layout changes, which leaves the other formats valid.
+inline constexpr ByteFormat SOLUTION_FORMAT = {"SOLN", 1};
+inline constexpr ByteFormat ROUTE_FORMAT = {"ROUT", 1};
+inline constexpr ByteFormat PROBLEM_DATA_FORMAT = {"PDAT", 1};
+inline constexpr ByteFormat MATRIX_FILE_FORMAT = {"PMAT", 1};
+inline constexpr ByteFormat INSTANCE_FILE_FORMAT = {"PINS", 1};
+
+namespace detail
+{
+// Identifies the underlying Value type, so that data written by a build with
+// one precision is not read by a build with another.
+inline constexpr uint8_t VALUE_KIND
+    = (std::is_floating_point_v<Value> ? 0x80 : 0x00) | sizeof(Value);
+
+template <typename T> struct IsMeasure : std::false_type
+{
+};
+
+template <MeasureType Type> struct IsMeasure<Measure<Type>> : std::true_type
+{
+};
+}  // namespace detail
+
+/**
+ * Writes values to a compact binary buffer, in native byte order. The buffer
+ * starts with a header of the format's tag and version, and the Value type.
+ */
+class ByteWriter
+{
+    std::string buffer_;
+
+public:
+    ByteWriter(ByteFormat const &format);
+
+    // Writes an arithmetic value, or the underlying value of a measure.
+    template <typename T> void write(T value);
+
+    // Writes count contiguous arithmetic values or measures.
+    template <typename T> void writeArray(T const *data, size_t count);
+
+    // Writes a length-prefixed string.
+    void writeString(std::string_view str);
+
+    // Returns the buffer written thus far. The writer is empty afterwards.
+    [[nodiscard]] std::string release();
+};
+
+/**
+ * Reads values from a binary buffer written by ByteWriter. Throws an
+ * std::invalid_argument when the header does not match the given format, or
+ * when the buffer is too short.
+ */
+class ByteReader
+{
+    std::string_view buffer_;
+
+    // Returns the next count bytes, and advances past them.
+    std::string_view take(size_t count);
+
+public:
+    ByteReader(std::string_view buffer, ByteFormat const &format);
+
+    // Reads an arithmetic value, or a measure.
+    template <typename T> [[nodiscard]] T read();
+
+    // Reads count contiguous arithmetic values or measures.
+    template <typename T> [[nodiscard]] std::vector<T> readArray(size_t count);
+
+    // Reads a length-prefixed string.
+    [[nodiscard]] std::string readString();
+
+    // Throws if there is any unread data left in the buffer.
+    void finish() const;
+};
+
+inline ByteWriter::ByteWriter(ByteFormat const &format)
+{
+    buffer_.append(format.tag, 4);
+    write(format.version);
+    write(detail::VALUE_KIND);
+}
+
+template <typename T> void ByteWriter::write(T value)
+{
+    if constexpr (detail::IsMeasure<T>::value)
+        write(value.get());
+    else
+    {
+        static_assert(std::is_arithmetic_v<T>);
+        buffer_.append(reinterpret_cast<char const *>(&value), sizeof(T));
+    }
+}
+
+template <typename T> void ByteWriter::writeArray(T const *data, size_t count)
+{
+    static_assert(std::is_arithmetic_v<T> || detail::IsMeasure<T>::value);
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    buffer_.append(reinterpret_cast<char const *>(data), count * sizeof(T));
+}
+
+inline void ByteWriter::writeString(std::string_view str)
+{
+    write<uint64_t>(str.size());
+    buffer_.append(str);
+}
+
+inline std::string ByteWriter::release() { return std::move(buffer_); }
+
+inline std::string_view ByteReader::take(size_t count)
+{
+    if (count > buffer_.size())
+        throw std::invalid_argument("Unexpected end of data.");
+
+    auto const result = buffer_.substr(0, count);
+    buffer_.remove_prefix(count);
+    return result;
+}
+
+inline ByteReader::ByteReader(std::string_view buffer,
+                              ByteFormat const &format)
+    : buffer_(buffer)
+{
+    auto const tag = std::string_view(format.tag, 4);
+    if (buffer_.size() < 4 || buffer_.substr(0, 4) != tag)
+        throw std::invalid_argument("Data does not describe this object.");
+
+    buffer_.remove_prefix(4);
+    if (read<uint32_t>() != format.version)
+        throw std::invalid_argument("Unsupported data format version.");
+
+    if (read<uint8_t>() != detail::VALUE_KIND)
+        throw std::invalid_argument("Data uses a different precision.");
+}
+
+template <typename T> T ByteReader::read()
+{
+    if constexpr (detail::IsMeasure<T>::value)
+        return read<Value>();
+    else
+    {
+        static_assert(std::is_arithmetic_v<T>);
+
+        T value;
+        std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+        return value;
+    }
+}
+
+template <typename T> std::vector<T> ByteReader::readArray(size_t count)
+{
+    static_assert(std::is_arithmetic_v<T> || detail::IsMeasure<T>::value);
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    if (count > buffer_.size() / sizeof(T))
+        throw std::invalid_argument("Unexpected end of data.");
+
+    auto const bytes = take(count * sizeof(T));
+    std::vector<T> values(count);
+    std::memcpy(values.data(), bytes.data(), bytes.size());
+    return values;
+}
+
+inline std::string ByteReader::readString()
+{
+    auto const size = read<uint64_t>();
+    return std::string(take(size));
+}
+
+inline void ByteReader::finish() const
+{
+    if (!buffer_.empty())
+        throw std::invalid_argument("Unexpected data after end of object.");
+}
+}  // namespace pyvrp
+
+#endif  // PYVRP_BYTES_H
@@ -64,6 +64,9 @@ class CostEvaluator
 public:
     CostEvaluator(Cost capacityPenalty, Cost timeWarpPenalty);
 
+    // Two evaluators are equal when they use the same penalty values.
+    bool operator==(CostEvaluator const &other) const = default;
+
     /**
      * Computes the total excess capacity penalty for the given load.
      */
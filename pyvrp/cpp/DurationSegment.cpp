@@ -11,13 +11,13 @@ Duration DurationSegment::twLate() const { return twLate_; }
 
 Duration DurationSegment::releaseTime() const { return releaseTime_; }
 
-DurationSegment::DurationSegment(size_t idx, ProblemData::Client const &client)
+DurationSegment::DurationSegment(ProblemData const &data, size_t idx)
     : idxFirst_(idx),
       idxLast_(idx),
-      duration_(client.serviceDuration),
+      duration_(data.attributes().serviceDuration[idx]),
       timeWarp_(0),
-      twEarly_(client.twEarly),
-      twLate_(client.twLate),
-      releaseTime_(client.releaseTime)
+      twEarly_(data.attributes().twEarly[idx]),
+      twLate_(data.attributes().twLate[idx]),
+      releaseTime_(data.attributes().releaseTime[idx])
 {
 }
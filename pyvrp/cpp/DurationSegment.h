@@ -105,8 +105,8 @@ public:
      */
     [[nodiscard]] Duration releaseTime() const;
 
-    // Construct from attributes of the given client.
-    DurationSegment(size_t idx, ProblemData::Client const &client);
+    // Construct from attributes of the given location.
+    DurationSegment(ProblemData const &data, size_t idx);
 
     // Construct from raw data.
     inline DurationSegment(size_t idxFirst,
@@ -7,9 +7,9 @@ Load LoadSegment::delivery() const { return delivery_; }
 
 Load LoadSegment::pickup() const { return pickup_; }
 
-LoadSegment::LoadSegment(ProblemData::Client const &client)
-    : delivery_(client.delivery),
-      pickup_(client.pickup),
-      load_(std::max(client.delivery, client.pickup))
+LoadSegment::LoadSegment(ProblemData const &data, size_t idx)
+    : delivery_(data.attributes().delivery[idx]),
+      pickup_(data.attributes().pickup[idx]),
+      load_(std::max(delivery_, pickup_))
 {
 }
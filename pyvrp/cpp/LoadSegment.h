@@ -49,8 +49,8 @@ public:
      */
     [[nodiscard]] inline Load load() const;
 
-    // Construct from attributes of the given client.
-    LoadSegment(ProblemData::Client const &client);
+    // Construct from attributes of the given location.
+    LoadSegment(ProblemData const &data, size_t idx);
 
     // Construct from raw data.
     inline LoadSegment(Load delivery, Load pickup, Load load);
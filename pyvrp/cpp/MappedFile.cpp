@@ -0,0 +1,144 @@
+#include "MappedFile.h"
+
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using pyvrp::MappedFile;
+using pyvrp::ReplacementFile;
+
+namespace
+{
+[[noreturn]] void fail(std::string const &path, char const *reason)
+{
+    std::ostringstream msg;
+    msg << "Could not " << reason << " file " << path << '.';
+    throw std::runtime_error(msg.str());
+}
+
+// Returns a temporary path next to the given path that is unique to this
+// process and call, so concurrent writers do not share temporary files.
+std::string temporaryPath(std::string const &path)
+{
+    static std::atomic<size_t> counter = 0;
+
+#ifdef _WIN32
+    auto const pid = _getpid();
+#else
+    auto const pid = getpid();
+#endif
+
+    std::ostringstream tmpPath;
+    tmpPath << path << ".tmp" << pid << '.' << counter++;
+    return tmpPath.str();
+}
+}  // namespace
+
+#ifdef _WIN32
+MappedFile::MappedFile(std::string const &path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        fail(path, "open");
+
+    size_ = static_cast<size_t>(file.tellg());
+    auto *data = new char[size_];
+    file.seekg(0);
+
+    if (!file.read(data, static_cast<std::streamsize>(size_)))
+    {
+        delete[] data;
+        fail(path, "read");
+    }
+
+    data_ = data;
+}
+
+MappedFile::~MappedFile() { delete[] data_; }
+#else
+MappedFile::MappedFile(std::string const &path)
+{
+    auto const fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        fail(path, "open");
+
+    struct stat stats;
+    if (fstat(fd, &stats) == -1)
+    {
+        close(fd);
+        fail(path, "inspect");
+    }
+
+    size_ = static_cast<size_t>(stats.st_size);
+    if (size_ == 0)  // mmap() does not accept empty mappings, but there is
+    {                // nothing to map anyway.
+        close(fd);
+        return;
+    }
+
+    // The mapping remains valid after the file descriptor has been closed.
+    auto *data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+        fail(path, "map");
+
+    data_ = static_cast<char const *>(data);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_)
+        munmap(const_cast<char *>(data_), size_);
+}
+#endif
+
+char const *MappedFile::data() const { return data_; }
+
+size_t MappedFile::size() const { return size_; }
+
+ReplacementFile::ReplacementFile(std::string const &path)
+    : path_(path),
+      tmpPath_(temporaryPath(path)),
+      file_(tmpPath_, std::ios::binary | std::ios::trunc)
+{
+    if (!file_)
+        fail(tmpPath_, "open");
+}
+
+ReplacementFile::~ReplacementFile()
+{
+    if (committed_)
+        return;
+
+    file_.close();
+    std::remove(tmpPath_.c_str());
+}
+
+std::ofstream &ReplacementFile::stream() { return file_; }
+
+void ReplacementFile::commit()
+{
+    file_.close();
+    if (!file_)
+        fail(tmpPath_, "write");
+
+    std::error_code error;
+    std::filesystem::rename(tmpPath_, path_, error);
+    if (error)
+        fail(path_, "replace");
+
+    committed_ = true;
+}
@@ -0,0 +1,81 @@
+#ifndef PYVRP_MAPPEDFILE_H
+#define PYVRP_MAPPEDFILE_H
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+namespace pyvrp
+{
+/**
+ * Read-only view of the contents of a file. On POSIX systems the file is
+ * memory-mapped, so its pages are loaded lazily, and shared through the page
+ * cache with other processes that map the same file. On other systems the
+ * file's contents are read into memory instead.
+ */
+class MappedFile
+{
+    char const *data_ = nullptr;
+    size_t size_ = 0;
+
+public:
+    /**
+     * Maps the file at the given path. Throws an std::runtime_error if the
+     * file cannot be opened or mapped.
+     *
+     * @param path Path of the file to map.
+     */
+    explicit MappedFile(std::string const &path);
+
+    MappedFile(MappedFile const &other) = delete;
+    MappedFile &operator=(MappedFile const &other) = delete;
+
+    ~MappedFile();
+
+    [[nodiscard]] char const *data() const;
+
+    [[nodiscard]] size_t size() const;
+};
+
+/**
+ * Output file that replaces the file at the given path only once it has been
+ * written completely. The contents are written to a temporary file next to
+ * the target, which is renamed over the target on commit. Truncating the
+ * target in place would invalidate the pages of any live mapping of it,
+ * whereas a mapping of the replaced file remains valid after the rename.
+ */
+class ReplacementFile
+{
+    std::string path_;
+    std::string tmpPath_;
+    std::ofstream file_;
+    bool committed_ = false;
+
+public:
+    /**
+     * Opens a temporary file next to the given path. Throws an
+     * std::runtime_error if that file cannot be opened.
+     *
+     * @param path Path of the file to replace.
+     */
+    explicit ReplacementFile(std::string const &path);
+
+    ReplacementFile(ReplacementFile const &other) = delete;
+    ReplacementFile &operator=(ReplacementFile const &other) = delete;
+
+    /**
+     * Removes the temporary file, unless it has been committed.
+     */
+    ~ReplacementFile();
+
+    [[nodiscard]] std::ofstream &stream();
+
+    /**
+     * Closes the temporary file and renames it over the target. Throws an
+     * std::runtime_error if either step fails.
+     */
+    void commit();
+};
+}  // namespace pyvrp
+
+#endif  // PYVRP_MAPPEDFILE_H
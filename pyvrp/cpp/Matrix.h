@@ -1,19 +1,158 @@
 #ifndef PYVRP_MATRIX_H
 #define PYVRP_MATRIX_H
 
+#include "Bytes.h"
+#include "MappedFile.h"
+#include "Metric.h"
+
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace pyvrp
 {
+// Matrix files start with a header of this many bytes, followed by the matrix
+// elements in row-major order. The header is padded to this size to keep the
+// elements aligned when the file is memory-mapped.
+inline constexpr size_t MATRIX_FILE_HEADER_SIZE = 64;
+
+namespace detail
+{
+// Integer measures (and plain values) can be stored using a narrower integer
+// type when all values fit, and widened again on access.
+template <typename T>
+struct IsNarrowable
+    : std::bool_constant<std::is_integral_v<Value>
+                         && (IsMeasure<T>::value || std::is_same_v<T, Value>)>
+{
+};
+
+template <typename Narrow, typename T> bool fitsIn(T const &lo, T const &hi)
+{
+    return static_cast<Value>(lo) >= std::numeric_limits<Narrow>::min()
+           && static_cast<Value>(hi) <= std::numeric_limits<Narrow>::max();
+}
+
+// Returns the size in bytes of the narrowest element type that can store all
+// count values at data without loss: int16_t, int32_t, or T itself.
+template <typename T> size_t narrowestWidth(T const *data, size_t count)
+{
+    if constexpr (IsNarrowable<T>::value)
+    {
+        if (count == 0)
+            return sizeof(T);
+
+        auto const [lo, hi] = std::minmax_element(data, data + count);
+        if (fitsIn<int16_t>(*lo, *hi))
+            return sizeof(int16_t);
+
+        if (fitsIn<int32_t>(*lo, *hi))
+            return sizeof(int32_t);
+    }
+
+    return sizeof(T);
+}
+
+// Writes count elements at data to the given file, converted to Stored.
+template <typename Stored, typename T>
+void writeElements(std::ofstream &file, T const *data, size_t count)
+{
+    if constexpr (std::is_same_v<Stored, T>)
+        file.write(reinterpret_cast<char const *>(data),
+                   static_cast<std::streamsize>(count * sizeof(T)));
+    else
+    {
+        // Elements are converted in blocks, so that large matrices need not
+        // be copied in full.
+        std::vector<Stored> block;
+        for (size_t offset = 0; offset < count; offset += 4096)
+        {
+            auto const end = std::min(offset + 4096, count);
+
+            block.clear();
+            for (size_t idx = offset; idx != end; ++idx)
+                block.push_back(static_cast<Stored>(data[idx]));
+
+            writeElements<Stored>(file, block.data(), block.size());
+        }
+    }
+}
+}  // namespace detail
+
+/**
+ * write_matrix(path: Union[str, os.PathLike], matrix: np.ndarray[int])
+ *
+ * Writes the given matrix to a binary matrix file at the given path. The path
+ * of such a file can be passed to :class:`~ProblemData` in place of a distance
+ * or duration matrix. The file is then memory-mapped rather than read into
+ * memory, so that its data is loaded lazily, and shared between all processes
+ * that use the same file. Integer matrices are written using 16 or 32-bit
+ * elements when all values fit.
+ *
+ * Parameters
+ * ----------
+ * path
+ *     Path of the matrix file to write.
+ * matrix
+ *     Two-dimensional matrix to write.
+ *
+ * Raises
+ * ------
+ * RuntimeError
+ *     When the file could not be written.
+ */
+template <typename T>
+void writeMatrixFile(std::string const &path,
+                     T const *data,
+                     size_t nRows,
+                     size_t nCols);
+
 template <typename T> class Matrix
 {
+    template <typename> friend class Matrix;
+
+    static constexpr bool IS_MEASURE = detail::IsMeasure<T>::value;
+    static constexpr bool IS_NARROWABLE = detail::IsNarrowable<T>::value;
+
     size_t cols_ = 0;           // The number of columns of the matrix
     size_t rows_ = 0;           // The number of rows of the matrix
-    std::vector<T> data_ = {};  // Data vector
+    std::vector<T> data_ = {};  // Data vector, empty if the data is read-only
+
+    // Read-only data that is shared between copies of this matrix: either a
+    // memory-mapped matrix file, an adopted buffer, compacted elements, or a
+    // metric that computes the elements.
+    std::shared_ptr<void const> shared_ = nullptr;
+
+    void const *elems_ = nullptr;  // First element, in data_ or in shared_
+    uint8_t width_ = sizeof(T);    // Size of each stored element, in bytes,
+                                   // or 0 if the elements are computed
+    bool mapped_ = false;          // Whether shared_ is a mapped file
+    bool adopted_ = false;         // Whether shared_ is an adopted buffer
+    bool packed_ = false;          // Whether only the lower triangle is
+                                   // stored, for symmetric matrices
+
+    // Stored row and column of each row and column index, if the matrix is
+    // relabelled. The stored matrix is then a permutation of this matrix.
+    std::shared_ptr<std::vector<uint32_t> const> slots_ = nullptr;
+
+    template <typename Stored> void storeShared(bool packed);
+
+    // Returns whether the (uncompacted) elements are those of a symmetric
+    // matrix.
+    [[nodiscard]] bool isSymmetric() const;
+
+    // Returns the position of the given element in the stored elements.
+    [[nodiscard]] size_t index(size_t row, size_t col) const;
 
 public:
     Matrix() = default;  // default is an empty matrix
@@ -28,16 +167,173 @@ public:
 
     explicit Matrix(std::vector<T> data, size_t nRows, size_t nCols);
 
+    Matrix(Matrix const &other);
+    Matrix(Matrix &&other);
+
+    Matrix &operator=(Matrix other);
+
+    /**
+     * Memory-maps the matrix file at the given path, as written by
+     * writeMatrixFile(). The returned matrix is read-only: its data must not
+     * be modified through the non-const accessors.
+     *
+     * @param path Path of the matrix file.
+     */
+    static Matrix fromFile(std::string const &path);
+
+    /**
+     * Returns a read-only matrix of the elements stored at the given offset
+     * in the given mapped file, without copying them. The elements are laid
+     * out as visit() passes them to its function. Throws an
+     * std::invalid_argument if the layout does not fit this matrix, or the
+     * file is too short.
+     *
+     * @param file   Mapped file that contains the elements.
+     * @param offset Offset of the first stored element in the file.
+     * @param width  Size of each stored element, in bytes.
+     * @param packed Whether only the lower triangle is stored.
+     * @param slots  Stored position of each row and column index, or empty if
+     *               the matrix is not relabelled.
+     * @param nRows  Number of rows.
+     * @param nCols  Number of columns.
+     */
+    static Matrix fromMapped(std::shared_ptr<MappedFile const> file,
+                             size_t offset,
+                             size_t width,
+                             bool packed,
+                             std::vector<uint32_t> slots,
+                             size_t nRows,
+                             size_t nCols);
+
+    /**
+     * Returns a read-only matrix that uses the given buffer of nRows * nCols
+     * elements, in row-major order, without copying it. The buffer must not
+     * be modified while it is in use.
+     *
+     * @param owner Keeps the buffer alive for as long as it is in use.
+     * @param data  First element of the buffer.
+     * @param nRows Number of rows.
+     * @param nCols Number of columns.
+     */
+    static Matrix fromBuffer(std::shared_ptr<void const> owner,
+                             T const *data,
+                             size_t nRows,
+                             size_t nCols);
+
+    /**
+     * Returns a read-only matrix whose elements are computed by the given
+     * metric, rather than stored. The matrix has a row and column for each
+     * location the metric is bound to.
+     *
+     * @param metric Metric that computes the elements.
+     */
+    static Matrix fromMetric(Metric metric);
+
+    /**
+     * Writes this matrix to a matrix file at the given path.
+     *
+     * @param path Path of the matrix file.
+     */
+    void toFile(std::string const &path) const;
+
+    /**
+     * Permutes the stored rows and columns of this square matrix, such that
+     * row and column idx are stored at position slots[idx]. Indices are not
+     * affected: element (row, col) stays the same, only its place in memory
+     * changes. Relabelling can improve cache locality when related rows and
+     * columns are looked up together. The matrix must be writeable, or use an
+     * adopted buffer, which is then copied.
+     *
+     * @param slots Stored position of each row and column index.
+     */
+    void relabel(std::vector<uint32_t> slots);
+
+    /**
+     * Moves the elements into read-only storage that is shared between copies
+     * of this matrix. Integer measures are stored using the narrowest of 16,
+     * 32 or 64-bit integers that fits all of them, which reduces the memory
+     * that element lookups pull in; the const accessors still return T. Of
+     * symmetric matrices of measures only the lower triangle is stored, which
+     * halves their memory. An adopted buffer is kept as-is when none of this
+     * applies. Does nothing for other read-only matrices.
+     */
+    void compact();
+
+    /**
+     * Shares the storage of the other matrix if both matrices are compacted,
+     * and store identical elements. Memory-mapped matrices are not compared,
+     * since that would require reading their files in full.
+     *
+     * @param other Matrix to share storage with.
+     * @return True if the storage is shared, false otherwise.
+     */
+    template <typename U> bool shareWith(Matrix<U> const &other);
+
+    /**
+     * Calls the given function with a pointer to the first stored element.
+     * That pointer is to int16_t or int32_t for a narrowed matrix, and to T
+     * otherwise. Packed matrices store their lower triangle row by row, and
+     * relabelled matrices their rows and columns in permuted order. The
+     * matrix must not be computed by a metric.
+     */
+    template <typename Fn> decltype(auto) visit(Fn &&fn) const;
+
+    // Mutable access is only possible for matrices that own their elements
+    // in order, and throws an std::runtime_error for read-only matrices:
+    // those that are mapped, adopted, narrowed, packed, relabelled, or share
+    // their elements.
     [[nodiscard]] decltype(auto) operator()(size_t row, size_t col);
     [[nodiscard]] decltype(auto) operator()(size_t row, size_t col) const;
 
     [[nodiscard]] T *data();
+
+    // Returns the elements in row-major order. Throws an std::runtime_error
+    // if the matrix is not stored as a dense array of T.
     [[nodiscard]] T const *data() const;
 
+    // Returns whether the elements are stored as a dense array of T in
+    // row-major order, that is, whether data() can be called. Matrices that
+    // are narrowed, packed, relabelled, or computed by a metric are not.
+    [[nodiscard]] bool isDense() const;
+
     [[nodiscard]] size_t numCols() const;
 
     [[nodiscard]] size_t numRows() const;
 
+    /**
+     * @return Whether this matrix is backed by a memory-mapped file.
+     */
+    [[nodiscard]] bool isMapped() const;
+
+    /**
+     * @return The metric that computes this matrix's elements, or nullptr if
+     *         the elements are stored.
+     */
+    [[nodiscard]] Metric const *metric() const;
+
+    /**
+     * @return Whether this matrix is symmetric, and stores only its lower
+     *         triangle.
+     */
+    [[nodiscard]] bool isPacked() const;
+
+    /**
+     * @return Whether the rows and columns of this matrix are stored in
+     *         permuted order. See relabel().
+     */
+    [[nodiscard]] bool isRelabelled() const;
+
+    /**
+     * @return Stored position of each row and column index, or nullptr if
+     *         this matrix is not relabelled. See relabel().
+     */
+    [[nodiscard]] std::vector<uint32_t> const *slots() const;
+
+    /**
+     * @return Number of stored elements.
+     */
+    [[nodiscard]] size_t storedSize() const;
+
     /**
      * @return Maximum element in the matrix.
      */
@@ -49,44 +345,536 @@ public:
     [[nodiscard]] size_t size() const;
 };
 
+template <typename T>
+void writeMatrixFile(std::string const &path,
+                     T const *data,
+                     size_t nRows,
+                     size_t nCols)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    auto const width = detail::narrowestWidth(data, nRows * nCols);
+
+    ByteWriter writer(MATRIX_FILE_FORMAT);
+    writer.write<uint64_t>(width);
+    writer.write<uint64_t>(nRows);
+    writer.write<uint64_t>(nCols);
+
+    auto header = writer.release();
+    assert(header.size() <= MATRIX_FILE_HEADER_SIZE);
+    header.resize(MATRIX_FILE_HEADER_SIZE, '\0');
+
+    ReplacementFile replacement(path);
+    auto &file = replacement.stream();
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    if (width == sizeof(int16_t))
+        detail::writeElements<int16_t>(file, data, nRows * nCols);
+    else if (width == sizeof(int32_t))
+        detail::writeElements<int32_t>(file, data, nRows * nCols);
+    else
+        detail::writeElements<T>(file, data, nRows * nCols);
+
+    if (!file)
+    {
+        std::ostringstream msg;
+        msg << "Could not write matrix file " << path << '.';
+        throw std::runtime_error(msg.str());
+    }
+
+    replacement.commit();
+}
+
 template <typename T>
 Matrix<T>::Matrix(size_t nRows, size_t nCols)
-    : cols_(nCols), rows_(nRows), data_(nRows * nCols)
+    : cols_(nCols), rows_(nRows), data_(nRows * nCols), elems_(data_.data())
 {
 }
 
 template <typename T>
 Matrix<T>::Matrix(std::vector<T> data, size_t nRows, size_t nCols)
-    : cols_(nCols), rows_(nRows), data_(std::move(data))
+    : cols_(nCols), rows_(nRows), data_(std::move(data)), elems_(data_.data())
 {
     assert(cols_ * rows_ == data_.size());
 }
 
+template <typename T>
+Matrix<T>::Matrix(Matrix<T> const &other)
+    : cols_(other.cols_),
+      rows_(other.rows_),
+      data_(other.data_),
+      shared_(other.shared_),
+      elems_(shared_ ? other.elems_ : data_.data()),
+      width_(other.width_),
+      mapped_(other.mapped_),
+      adopted_(other.adopted_),
+      packed_(other.packed_),
+      slots_(other.slots_)
+{
+}
+
+template <typename T>
+Matrix<T>::Matrix(Matrix<T> &&other)
+    : cols_(other.cols_),
+      rows_(other.rows_),
+      data_(std::move(other.data_)),
+      shared_(std::move(other.shared_)),
+      elems_(shared_ ? other.elems_ : data_.data()),
+      width_(other.width_),
+      mapped_(other.mapped_),
+      adopted_(other.adopted_),
+      packed_(other.packed_),
+      slots_(std::move(other.slots_))
+{
+    other.cols_ = 0;
+    other.rows_ = 0;
+    other.data_.clear();
+    other.elems_ = other.data_.data();
+    other.width_ = sizeof(T);
+    other.mapped_ = false;
+    other.adopted_ = false;
+    other.packed_ = false;
+}
+
+template <typename T> Matrix<T> &Matrix<T>::operator=(Matrix<T> other)
+{
+    cols_ = other.cols_;
+    rows_ = other.rows_;
+    data_ = std::move(other.data_);
+    shared_ = std::move(other.shared_);
+    elems_ = shared_ ? other.elems_ : data_.data();
+    width_ = other.width_;
+    mapped_ = other.mapped_;
+    adopted_ = other.adopted_;
+    packed_ = other.packed_;
+    slots_ = std::move(other.slots_);
+    return *this;
+}
+
+template <typename T> Matrix<T> Matrix<T>::fromFile(std::string const &path)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    auto file = std::make_shared<MappedFile const>(path);
+    if (file->size() < MATRIX_FILE_HEADER_SIZE)
+        throw std::invalid_argument("File does not describe a matrix.");
+
+    std::string_view const header(file->data(), MATRIX_FILE_HEADER_SIZE);
+    ByteReader reader(header, MATRIX_FILE_FORMAT);
+    auto const elemSize = reader.read<uint64_t>();
+    auto const nRows = reader.read<uint64_t>();
+    auto const nCols = reader.read<uint64_t>();
+
+    auto const isNarrow = elemSize == sizeof(int16_t)  // narrowed elements
+                          || elemSize == sizeof(int32_t);
+    if (elemSize != sizeof(T) && !(IS_NARROWABLE && isNarrow))
+        throw std::invalid_argument("Matrix file has wrong element size.");
+
+    auto const dataSize = file->size() - MATRIX_FILE_HEADER_SIZE;
+    if (nCols != 0 && nRows > dataSize / elemSize / nCols)
+        throw std::invalid_argument("Matrix file is too short.");
+
+    if (nRows * nCols * elemSize != dataSize)
+        throw std::invalid_argument("Matrix file size does not match shape.");
+
+    return fromMapped(std::move(file),
+                      MATRIX_FILE_HEADER_SIZE,
+                      elemSize,
+                      false,
+                      {},
+                      nRows,
+                      nCols);
+}
+
+template <typename T>
+Matrix<T> Matrix<T>::fromMapped(std::shared_ptr<MappedFile const> file,
+                                size_t offset,
+                                size_t width,
+                                bool packed,
+                                std::vector<uint32_t> slots,
+                                size_t nRows,
+                                size_t nCols)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    auto const isNarrow = width == sizeof(int16_t)  // narrowed elements
+                          || width == sizeof(int32_t);
+    if (width != sizeof(T) && !(IS_NARROWABLE && isNarrow))
+        throw std::invalid_argument("Matrix has wrong element size.");
+
+    // Slots are 32-bit, so larger matrices cannot be relabelled. This also
+    // ensures the number of elements below does not overflow.
+    auto constexpr maxDim = std::numeric_limits<uint32_t>::max();
+    if (nRows > maxDim || nCols > maxDim)
+        throw std::invalid_argument("Matrix is too large.");
+
+    if ((packed || !slots.empty()) && nRows != nCols)
+        throw std::invalid_argument("Matrix must be square.");
+
+    if (!slots.empty()
+        && (slots.size() != nRows
+            || std::any_of(slots.begin(), slots.end(), [&](auto slot) {
+                   return slot >= nRows;
+               })))
+        throw std::invalid_argument("Invalid matrix slots.");
+
+    auto const count = packed ? nRows * (nRows + 1) / 2 : nRows * nCols;
+    if (offset % width != 0 || offset > file->size()
+        || count > (file->size() - offset) / width)
+        throw std::invalid_argument("File is too short to contain matrix.");
+
+    Matrix<T> matrix;
+    matrix.cols_ = nCols;
+    matrix.rows_ = nRows;
+    matrix.elems_ = file->data() + offset;
+    matrix.width_ = static_cast<uint8_t>(width);
+    matrix.mapped_ = true;
+    matrix.packed_ = packed;
+    matrix.shared_ = std::move(file);
+
+    if (!slots.empty())
+        matrix.slots_
+            = std::make_shared<std::vector<uint32_t> const>(std::move(slots));
+
+    return matrix;
+}
+
+template <typename T>
+Matrix<T> Matrix<T>::fromBuffer(std::shared_ptr<void const> owner,
+                                T const *data,
+                                size_t nRows,
+                                size_t nCols)
+{
+    Matrix<T> matrix;
+    matrix.cols_ = nCols;
+    matrix.rows_ = nRows;
+    matrix.elems_ = data;
+    matrix.adopted_ = true;
+    matrix.shared_ = std::move(owner);
+    return matrix;
+}
+
+template <typename T> Matrix<T> Matrix<T>::fromMetric(Metric metric)
+{
+    static_assert(IS_MEASURE);
+
+    auto shared = std::make_shared<Metric const>(std::move(metric));
+
+    Matrix<T> matrix;
+    matrix.cols_ = shared->numLocations();
+    matrix.rows_ = shared->numLocations();
+    matrix.elems_ = shared.get();
+    matrix.width_ = 0;
+    matrix.shared_ = std::move(shared);
+    return matrix;
+}
+
+template <typename T> void Matrix<T>::toFile(std::string const &path) const
+{
+    if (metric())
+        throw std::invalid_argument("Cannot write a computed matrix to file.");
+
+    if (packed_ || slots_)  // matrix files store all elements in order, so
+    {                       // we unpack first
+        std::vector<T> elems;
+        elems.reserve(size());
+        for (size_t row = 0; row != rows_; ++row)
+            for (size_t col = 0; col != cols_; ++col)
+                elems.push_back((*this)(row, col));
+
+        writeMatrixFile(path, elems.data(), rows_, cols_);
+        return;
+    }
+
+    visit([&](auto const *elems) {
+        writeMatrixFile(path, elems, rows_, cols_);
+    });
+}
+
+template <typename T> void Matrix<T>::relabel(std::vector<uint32_t> slots)
+{
+    assert(!shared_ || adopted_);
+    assert(!slots_ && rows_ == cols_ && slots.size() == rows_);
+
+    auto const *elems = static_cast<T const *>(elems_);
+    std::vector<T> permuted(size());
+    for (size_t row = 0; row != rows_; ++row)
+    {
+        auto *const stored = permuted.data() + cols_ * slots[row];
+        for (size_t col = 0; col != cols_; ++col)
+            stored[slots[col]] = elems[cols_ * row + col];
+    }
+
+    data_ = std::move(permuted);
+    elems_ = data_.data();
+    adopted_ = false;
+    shared_ = nullptr;  // releases any adopted buffer
+    slots_ = std::make_shared<std::vector<uint32_t> const>(std::move(slots));
+}
+
+
+template <typename T>
+template <typename Stored>
+void Matrix<T>::storeShared(bool packed)
+{
+    std::shared_ptr<std::vector<Stored> const> elems;
+    if constexpr (std::is_same_v<Stored, T>)
+        if (!packed)
+        {
+            if (adopted_)  // then the adopted buffer can be used as-is
+            {
+                adopted_ = false;
+                return;
+            }
+
+            // The data vector can be moved as-is.
+            elems = std::make_shared<std::vector<T> const>(std::move(data_));
+        }
+
+    if (!elems)
+    {
+        auto const *src = static_cast<T const *>(elems_);
+
+        std::vector<Stored> stored;
+        stored.reserve(packed ? rows_ * (rows_ + 1) / 2 : size());
+
+        for (size_t row = 0; row != rows_; ++row)
+            for (size_t col = 0; col != (packed ? row + 1 : cols_); ++col)
+                stored.push_back(static_cast<Stored>(src[cols_ * row + col]));
+
+        elems = std::make_shared<std::vector<Stored> const>(std::move(stored));
+    }
+
+    elems_ = elems->data();
+    width_ = sizeof(Stored);
+    adopted_ = false;
+    packed_ = packed;
+    shared_ = std::move(elems);  // releases any adopted buffer
+    data_ = std::vector<T>();    // releases any remaining elements
+}
+
+
+template <typename T> bool Matrix<T>::isSymmetric() const
+{
+    if (rows_ != cols_)
+        return false;
+
+    auto const *elems = static_cast<T const *>(elems_);
+    for (size_t row = 0; row != rows_; ++row)
+        for (size_t col = 0; col != row; ++col)
+            if (elems[cols_ * row + col] != elems[cols_ * col + row])
+                return false;
+
+    return true;
+}
+
+template <typename T> void Matrix<T>::compact()
+{
+    if (shared_ && !adopted_)  // then the data is already compact
+        return;
+
+    bool packed = false;
+    if constexpr (IS_MEASURE)
+        packed = isSymmetric();
+
+    if constexpr (IS_NARROWABLE)
+    {
+        auto const *elems = static_cast<T const *>(elems_);
+        auto const width = detail::narrowestWidth(elems, size());
+        if (width == sizeof(int16_t))
+            return storeShared<int16_t>(packed);
+
+        if (width == sizeof(int32_t))
+            return storeShared<int32_t>(packed);
+    }
+
+    storeShared<T>(packed);
+}
+
+template <typename T>
+template <typename U>
+bool Matrix<T>::shareWith(Matrix<U> const &other)
+{
+    static_assert(sizeof(T) == sizeof(U)
+                  && IS_NARROWABLE == Matrix<U>::IS_NARROWABLE
+                  && std::is_trivially_copyable_v<T>
+                  && std::is_trivially_copyable_v<U>);
+
+    if (!shared_ || !other.shared_ || mapped_ || other.mapped_)
+        return false;
+
+    if (adopted_ || other.adopted_)  // only compacted matrices are shared
+        return false;
+
+    if (metric() || other.metric())  // computed matrices store nothing to
+        return false;                // share
+
+    if (rows_ != other.rows_ || cols_ != other.cols_ || width_ != other.width_
+        || packed_ != other.packed_ || !slots_ != !other.slots_)
+        return false;
+
+    if (slots_ && slots_ != other.slots_ && *slots_ != *other.slots_)
+        return false;
+
+    if (elems_ != other.elems_
+        && std::memcmp(elems_, other.elems_, storedSize() * width_) != 0)
+        return false;
+
+    shared_ = other.shared_;
+    elems_ = other.elems_;
+    slots_ = other.slots_;
+    return true;
+}
+
+template <typename T>
+template <typename Fn>
+decltype(auto) Matrix<T>::visit(Fn &&fn) const
+{
+    assert(!metric());
+
+    if constexpr (IS_NARROWABLE)
+    {
+        if (width_ == sizeof(int16_t))
+            return fn(static_cast<int16_t const *>(elems_));
+
+        if (width_ == sizeof(int32_t))
+            return fn(static_cast<int32_t const *>(elems_));
+    }
+
+    return fn(static_cast<T const *>(elems_));
+}
+
+template <typename T>
+size_t Matrix<T>::index(size_t row, size_t col) const
+{
+    if (slots_)
+    {
+        row = (*slots_)[row];
+        col = (*slots_)[col];
+    }
+
+    if (!packed_)
+        return cols_ * row + col;
+
+    // Element (row, col) of a symmetric matrix equals element (col, row), so
+    // we look up whichever of the two is in the lower triangle. Swapping row
+    // and col is written without branches, since a branch on random pairs
+    // would be mispredicted half the time.
+    auto const hi = std::max(row, col);
+    auto const lo = row + col - hi;
+    return hi * (hi + 1) / 2 + lo;
+}
+
 template <typename T>
 decltype(auto) Matrix<T>::operator()(size_t row, size_t col)
 {
-    return data_[cols_ * row + col];
+    if (shared_ || slots_)
+        throw std::runtime_error("Matrix is read-only.");
+
+    return data_[index(row, col)];
 }
 
 template <typename T>
 decltype(auto) Matrix<T>::operator()(size_t row, size_t col) const
 {
-    return data_[cols_ * row + col];
+    auto const idx = index(row, col);
+
+    if constexpr (IS_NARROWABLE)
+    {
+        // The width is fixed once the matrix is constructed, so these
+        // branches are very well predicted in tight loops.
+        if (width_ == sizeof(int16_t))
+            return T(static_cast<int16_t const *>(elems_)[idx]);
+
+        if (width_ == sizeof(int32_t))
+            return T(static_cast<int32_t const *>(elems_)[idx]);
+    }
+
+    if constexpr (IS_MEASURE)
+    {
+        if (width_ == sizeof(T))
+            return T(static_cast<T const *>(elems_)[idx]);
+
+        return T((*static_cast<Metric const *>(elems_))(row, col));
+    }
+    else if constexpr (IS_NARROWABLE)
+        return T(static_cast<T const *>(elems_)[idx]);
+    else
+        return static_cast<T const *>(elems_)[idx];
+}
+
+template <typename T> T *Matrix<T>::data()
+{
+    if (shared_ || slots_)
+        throw std::runtime_error("Matrix is read-only.");
+
+    return data_.data();
 }
 
-template <typename T> T *Matrix<T>::data() { return data_.data(); }
-template <typename T> T const *Matrix<T>::data() const { return data_.data(); }
+template <typename T> T const *Matrix<T>::data() const
+{
+    if (!isDense())
+        throw std::runtime_error("Matrix is not stored as a dense array.");
+
+    return static_cast<T const *>(elems_);
+}
+
+template <typename T> bool Matrix<T>::isDense() const
+{
+    return width_ == sizeof(T) && !packed_ && !slots_;
+}
 
 template <typename T> size_t Matrix<T>::numCols() const { return cols_; }
 
 template <typename T> size_t Matrix<T>::numRows() const { return rows_; }
 
+template <typename T> bool Matrix<T>::isMapped() const { return mapped_; }
+
+template <typename T> Metric const *Matrix<T>::metric() const
+{
+    if constexpr (IS_MEASURE)
+        if (width_ == 0)
+            return static_cast<Metric const *>(elems_);
+
+    return nullptr;
+}
+
+template <typename T> bool Matrix<T>::isPacked() const { return packed_; }
+
+template <typename T> bool Matrix<T>::isRelabelled() const
+{
+    return slots_ != nullptr;
+}
+
+template <typename T>
+std::vector<uint32_t> const *Matrix<T>::slots() const
+{
+    return slots_.get();
+}
+
+template <typename T> size_t Matrix<T>::storedSize() const
+{
+    return packed_ ? rows_ * (rows_ + 1) / 2 : size();
+}
+
 template <typename T> T Matrix<T>::max() const
 {
-    return *std::max_element(data_.begin(), data_.end());
+    if (metric())
+    {
+        T result = (*this)(0, 0);
+        for (size_t row = 0; row != rows_; ++row)
+            for (size_t col = 0; col != cols_; ++col)
+                result = std::max(result, (*this)(row, col));
+
+        return result;
+    }
+
+    return visit([&](auto const *elems) {
+        return T(*std::max_element(elems, elems + storedSize()));
+    });
 }
 
-template <typename T> size_t Matrix<T>::size() const { return data_.size(); }
+template <typename T> size_t Matrix<T>::size() const { return rows_ * cols_; }
 }  // namespace pyvrp
 
 #endif  // PYVRP_MATRIX_H
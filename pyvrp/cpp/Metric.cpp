@@ -0,0 +1,65 @@
+#include "Metric.h"
+
+#include <numbers>
+#include <stdexcept>
+
+using pyvrp::Metric;
+
+Metric::Metric(std::string const &kind, double scale, double degreesPerUnit)
+    : scale_(scale), degreesPerUnit_(degreesPerUnit)
+{
+    if (kind == "euclidean")
+        kind_ = Kind::EUCLIDEAN;
+    else if (kind == "haversine")
+        kind_ = Kind::HAVERSINE;
+    else
+        throw std::invalid_argument("Metric kind must be 'euclidean' or "
+                                    "'haversine'.");
+
+    if (!(scale > 0))
+        throw std::invalid_argument("scale must be > 0.");
+
+    if (!(degreesPerUnit > 0))
+        throw std::invalid_argument("degrees_per_unit must be > 0.");
+}
+
+Metric Metric::bind(
+    std::vector<std::pair<Coordinate, Coordinate>> const &coords) const
+{
+    Metric metric = *this;
+    metric.points_.clear();
+    metric.points_.reserve(coords.size());
+
+    auto const radiansPerUnit = degreesPerUnit_ * std::numbers::pi / 180;
+    for (auto const &[x, y] : coords)
+    {
+        auto const xVal = static_cast<double>(x);
+        auto const yVal = static_cast<double>(y);
+
+        if (kind_ == Kind::EUCLIDEAN)
+        {
+            metric.points_.push_back({xVal, yVal, 0});
+            continue;
+        }
+
+        // Point on the earth's surface for this longitude and latitude.
+        auto const lon = xVal * radiansPerUnit;
+        auto const lat = yVal * radiansPerUnit;
+        metric.points_.push_back({EARTH_RADIUS * std::cos(lat) * std::cos(lon),
+                                  EARTH_RADIUS * std::cos(lat) * std::sin(lon),
+                                  EARTH_RADIUS * std::sin(lat)});
+    }
+
+    return metric;
+}
+
+size_t Metric::numLocations() const { return points_.size(); }
+
+std::string Metric::kind() const
+{
+    return kind_ == Kind::EUCLIDEAN ? "euclidean" : "haversine";
+}
+
+double Metric::scale() const { return scale_; }
+
+double Metric::degreesPerUnit() const { return degreesPerUnit_; }
@@ -0,0 +1,137 @@
+#ifndef PYVRP_METRIC_H
+#define PYVRP_METRIC_H
+
+#include "Measure.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pyvrp
+{
+/**
+ * Metric(
+ *     kind: str = "euclidean",
+ *     scale: float = 1.0,
+ *     degrees_per_unit: float = 1.0,
+ * )
+ *
+ * Computes distances or durations from the coordinates of the clients and
+ * depots, when they are needed. A metric can be passed to
+ * :class:`~ProblemData` in place of a distance or duration matrix. No matrix
+ * is then stored, so memory use grows linearly rather than quadratically with
+ * the number of locations.
+ *
+ * Parameters
+ * ----------
+ * kind
+ *     Either ``"euclidean"``, for the straight-line distance between the
+ *     coordinates, or ``"haversine"``, for the great-circle distance in
+ *     metres. The haversine metric takes ``x`` as the longitude, and ``y`` as
+ *     the latitude.
+ * scale
+ *     Factor that computed distances are multiplied with. For durations, this
+ *     is typically one over the travel speed. The result is rounded to the
+ *     nearest integer, unless PyVRP is compiled with double precision.
+ * degrees_per_unit
+ *     Degrees per coordinate unit, used by the haversine metric. For example,
+ *     this is ``1e-6`` when the coordinates are given in micro degrees.
+ *
+ * Raises
+ * ------
+ * ValueError
+ *     When ``kind`` is not understood, or ``scale`` or ``degrees_per_unit``
+ *     is not positive.
+ */
+class Metric
+{
+    enum class Kind
+    {
+        EUCLIDEAN,
+        HAVERSINE,
+    };
+
+    // Mean radius of the earth, in metres.
+    static constexpr double EARTH_RADIUS = 6'371'008.8;
+
+    // Location in space, such that the distance between two locations follows
+    // directly from the straight-line distance between their points.
+    struct Point
+    {
+        double x;
+        double y;
+        double z;
+    };
+
+    Kind kind_;
+    double scale_;
+    double degreesPerUnit_;
+    std::vector<Point> points_ = {};  // Points of the bound locations
+
+public:
+    Metric(std::string const &kind = "euclidean",
+           double scale = 1.0,
+           double degreesPerUnit = 1.0);
+
+    /**
+     * Returns a copy of this metric that computes the distances between
+     * locations with the given coordinates.
+     *
+     * @param coords Coordinates (x, y) of each location.
+     */
+    [[nodiscard]] Metric
+    bind(std::vector<std::pair<Coordinate, Coordinate>> const &coords) const;
+
+    /**
+     * Computes the distance between the given bound locations.
+     */
+    [[nodiscard]] inline Value operator()(size_t from, size_t to) const;
+
+    /**
+     * Number of locations this metric is bound to.
+     */
+    [[nodiscard]] size_t numLocations() const;
+
+    /**
+     * Kind of distance computed by this metric.
+     */
+    [[nodiscard]] std::string kind() const;
+
+    /**
+     * Factor that computed distances are multiplied with.
+     */
+    [[nodiscard]] double scale() const;
+
+    /**
+     * Degrees per coordinate unit.
+     */
+    [[nodiscard]] double degreesPerUnit() const;
+};
+
+Value Metric::operator()(size_t from, size_t to) const
+{
+    auto const &first = points_[from];
+    auto const &second = points_[to];
+
+    auto const dx = first.x - second.x;
+    auto const dy = first.y - second.y;
+    auto const dz = first.z - second.z;
+    auto dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+    // The haversine points lie on a sphere, so we convert the chord length
+    // between them into the length of the arc.
+    if (kind_ == Kind::HAVERSINE)
+        dist = 2 * EARTH_RADIUS
+               * std::asin(std::min(dist / (2 * EARTH_RADIUS), 1.0));
+
+    if constexpr (std::is_floating_point_v<Value>)
+        return scale_ * dist;
+    else
+        return static_cast<Value>(std::round(scale_ * dist));
+}
+}  // namespace pyvrp
+
+#endif  // PYVRP_METRIC_H
@@ -1,12 +1,18 @@
 #include "ProblemData.h"
+#include "Bytes.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <limits>
 #include <numeric>
 
+using pyvrp::Coordinate;
+using pyvrp::Cost;
 using pyvrp::Distance;
 using pyvrp::Duration;
 using pyvrp::Matrix;
+using pyvrp::Metric;
 using pyvrp::ProblemData;
 
 namespace
@@ -21,6 +27,324 @@ static char *duplicate(char const *src)
     std::strcpy(dst, src);
     return dst;
 }
+
+// Collects the attributes of the given depots and clients, per attribute.
+ProblemData::LocationAttributes
+attributesOf(std::vector<ProblemData::Depot> const &depots,
+             std::vector<ProblemData::Client> const &clients)
+{
+    ProblemData::LocationAttributes attrs;
+
+    for (auto const &depot : depots)
+    {
+        attrs.x.push_back(depot.x);
+        attrs.y.push_back(depot.y);
+        attrs.delivery.push_back(0);
+        attrs.pickup.push_back(0);
+        attrs.serviceDuration.push_back(0);
+        attrs.twEarly.push_back(depot.twEarly);
+        attrs.twLate.push_back(depot.twLate);
+        attrs.releaseTime.push_back(0);
+        attrs.prize.push_back(0);
+    }
+
+    for (auto const &client : clients)
+    {
+        attrs.x.push_back(client.x);
+        attrs.y.push_back(client.y);
+        attrs.delivery.push_back(client.delivery);
+        attrs.pickup.push_back(client.pickup);
+        attrs.serviceDuration.push_back(client.serviceDuration);
+        attrs.twEarly.push_back(client.twEarly);
+        attrs.twLate.push_back(client.twLate);
+        attrs.releaseTime.push_back(client.releaseTime);
+        attrs.prize.push_back(client.prize);
+    }
+
+    return attrs;
+}
+
+// Throws if the given square matrix has a non-zero diagonal element.
+template <typename T>
+void checkDiagonal(Matrix<T> const &matrix, char const *msg)
+{
+    for (size_t idx = 0; idx != matrix.numRows(); ++idx)
+        if (matrix(idx, idx) != 0)
+            throw std::invalid_argument(msg);
+}
+
+// Moves the given value into immutable storage that can be shared.
+template <typename T> std::shared_ptr<T const> shared(T value)
+{
+    return std::make_shared<T const>(std::move(value));
+}
+
+// Time warp can only occur when some time window closes, or when a vehicle
+// type has a maximum route duration. Without those, all time-related
+// evaluation can be skipped.
+bool anyTimeWindows(std::vector<ProblemData::Client> const &clients,
+                    std::vector<ProblemData::Depot> const &depots,
+                    std::vector<ProblemData::VehicleType> const &vehicleTypes)
+{
+    auto const maxDur = std::numeric_limits<Duration>::max();
+
+    for (auto const &client : clients)
+        if (client.twLate != maxDur)
+            return true;
+
+    for (auto const &depot : depots)
+        if (depot.twLate != maxDur)
+            return true;
+
+    for (auto const &vehicleType : vehicleTypes)
+        if (vehicleType.twLate != maxDur || vehicleType.maxDuration != maxDur)
+            return true;
+
+    return false;
+}
+
+template <typename T>
+void writeMatrix(pyvrp::ByteWriter &writer, Matrix<T> const &matrix)
+{
+    writer.write<uint64_t>(matrix.numRows());
+    writer.write<uint64_t>(matrix.numCols());
+
+    // Computed matrices are written as their metric, which is bound to the
+    // instance's locations again when the instance is read.
+    if (auto const *metric = matrix.metric())
+    {
+        writer.write<uint8_t>(0);
+        writer.writeString(metric->kind());
+        writer.write(metric->scale());
+        writer.write(metric->degreesPerUnit());
+        return;
+    }
+
+    // Matrices are written as stored, so narrowed and packed matrices stay
+    // compact.
+    matrix.visit([&](auto const *elems) {
+        writer.write<uint8_t>(sizeof(*elems));
+        writer.write<uint8_t>(matrix.isPacked());
+
+        if (!matrix.isRelabelled())
+        {
+            writer.writeArray(elems, matrix.storedSize());
+            return;
+        }
+
+        // Relabelled matrices are written in index order. Relabelling depends
+        // only on the locations, so it is repeated when the instance is read.
+        using Stored = std::remove_cv_t<std::remove_pointer_t<decltype(elems)>>;
+        std::vector<Stored> ordered;
+        ordered.reserve(matrix.storedSize());
+
+        for (size_t row = 0; row != matrix.numRows(); ++row)
+        {
+            auto const numCols = matrix.isPacked() ? row + 1 : matrix.numCols();
+            for (size_t col = 0; col != numCols; ++col)
+                ordered.push_back(static_cast<Stored>(matrix(row, col)));
+        }
+
+        writer.writeArray(ordered.data(), ordered.size());
+    });
+}
+
+template <typename T, typename Stored>
+std::vector<T> readElements(pyvrp::ByteReader &reader, size_t count)
+{
+    auto const elems = reader.readArray<Stored>(count);
+    return std::vector<T>(elems.begin(), elems.end());
+}
+
+template <typename T> Matrix<T> readMatrix(pyvrp::ByteReader &reader)
+{
+    auto const numRows = reader.read<uint64_t>();
+    auto const numCols = reader.read<uint64_t>();
+
+    if (numCols != 0 && numRows > std::numeric_limits<size_t>::max() / numCols)
+        throw std::invalid_argument("Invalid matrix dimensions.");
+
+    auto const width = reader.read<uint8_t>();
+    auto const size = numRows * numCols;
+
+    if (width == 0)  // computed by a metric
+    {
+        auto const kind = reader.readString();
+        auto const scale = reader.read<double>();
+        auto const degreesPerUnit = reader.read<double>();
+        return Matrix<T>::fromMetric(Metric(kind, scale, degreesPerUnit));
+    }
+
+    auto const packed = reader.read<uint8_t>();
+    if (packed && numRows != numCols)
+        throw std::invalid_argument("Invalid matrix dimensions.");
+
+    auto const count = packed ? numRows * (numRows + 1) / 2 : size;
+
+    std::vector<T> data;
+    if (width == sizeof(T))
+        data = reader.readArray<T>(count);
+    else if (width == sizeof(int16_t))
+        data = readElements<T, int16_t>(reader, count);
+    else if (width == sizeof(int32_t))
+        data = readElements<T, int32_t>(reader, count);
+    else
+        throw std::invalid_argument("Invalid matrix element size.");
+
+    if (!packed)
+        return Matrix<T>(std::move(data), numRows, numCols);
+
+    // Packed matrices store their lower triangle row by row, which we mirror
+    // to obtain the full matrix. ProblemData packs it again.
+    Matrix<T> matrix(numRows, numCols);
+    for (size_t row = 0, idx = 0; row != numRows; ++row)
+        for (size_t col = 0; col <= row; ++col, ++idx)
+            matrix(row, col) = matrix(col, row) = data[idx];
+
+    return matrix;
+}
+
+// Binds a matrix that is computed by a metric to the given locations, so that
+// it computes the distances or durations between them. Other matrices are
+// returned as-is.
+template <typename T>
+Matrix<T> bound(Matrix<T> matrix,
+                std::vector<ProblemData::Depot> const &depots,
+                std::vector<ProblemData::Client> const &clients)
+{
+    auto const *metric = matrix.metric();
+    if (!metric)
+        return matrix;
+
+    std::vector<std::pair<pyvrp::Coordinate, pyvrp::Coordinate>> coords;
+    coords.reserve(depots.size() + clients.size());
+
+    for (auto const &depot : depots)
+        coords.emplace_back(depot.x, depot.y);
+
+    for (auto const &client : clients)
+        coords.emplace_back(client.x, client.y);
+
+    return Matrix<T>::fromMetric(metric->bind(coords));
+}
+
+// Smaller matrices fit in the processor's caches, and are not relabelled.
+constexpr size_t RELABEL_MIN_LOCATIONS = 1'000;
+
+// Returns the position of (x, y) along a Hilbert curve through a square grid
+// of side 2^16. Points that are close on the curve are also close in the grid.
+uint64_t hilbertIndex(uint32_t x, uint32_t y)
+{
+    uint64_t index = 0;
+    for (uint32_t side = 1 << 15; side > 0; side /= 2)
+    {
+        uint32_t const rx = (x & side) > 0;
+        uint32_t const ry = (y & side) > 0;
+        index += static_cast<uint64_t>(side) * side * ((3 * rx) ^ ry);
+
+        if (ry == 0)  // rotate the quadrant, so the curve stays contiguous
+        {
+            if (rx == 1)
+            {
+                x = side - 1 - x;
+                y = side - 1 - y;
+            }
+
+            std::swap(x, y);
+        }
+    }
+
+    return index;
+}
+
+// Returns a stored position for each location, such that clients that are
+// close to each other are also stored close to each other. Depots keep their
+// positions, and clients are ordered along a Hilbert curve through their
+// coordinates.
+std::vector<uint32_t>
+spatialSlots(std::vector<ProblemData::Depot> const &depots,
+             std::vector<ProblemData::Client> const &clients)
+{
+    std::vector<uint32_t> slots(depots.size() + clients.size());
+    std::iota(slots.begin(), slots.end(), 0);
+
+    if (clients.empty())
+        return slots;
+
+    auto const [minX, maxX] = std::minmax_element(
+        clients.begin(), clients.end(), [](auto const &lhs, auto const &rhs) {
+            return lhs.x < rhs.x;
+        });
+
+    auto const [minY, maxY] = std::minmax_element(
+        clients.begin(), clients.end(), [](auto const &lhs, auto const &rhs) {
+            return lhs.y < rhs.y;
+        });
+
+    // Scales the given coordinate onto the grid of the Hilbert curve.
+    auto const toGrid = [](Coordinate coord, Coordinate min, Coordinate max) {
+        auto const range = static_cast<double>(max - min);
+        auto const offset = static_cast<double>(coord - min);
+        return range > 0 ? static_cast<uint32_t>(offset / range * 65'535) : 0;
+    };
+
+    std::vector<std::pair<uint64_t, uint32_t>> curve;
+    curve.reserve(clients.size());
+    for (uint32_t idx = 0; idx != clients.size(); ++idx)
+    {
+        auto const &client = clients[idx];
+        auto const x = toGrid(client.x, minX->x, maxX->x);
+        auto const y = toGrid(client.y, minY->y, maxY->y);
+        curve.emplace_back(hilbertIndex(x, y), idx);
+    }
+
+    std::sort(curve.begin(), curve.end());
+    auto const numDepots = static_cast<uint32_t>(depots.size());
+    for (uint32_t pos = 0; pos != curve.size(); ++pos)
+        slots[numDepots + curve[pos].second] = numDepots + pos;
+
+    return slots;
+}
+
+// Relabels the given matrix such that nearby clients are stored near each
+// other, if the instance is large enough for that to matter. The search looks
+// up distances and durations between nearby clients together, which then
+// share cache lines. Read-only matrices are returned as-is.
+template <typename T>
+Matrix<T> relabelled(Matrix<T> matrix,
+                     std::vector<ProblemData::Depot> const &depots,
+                     std::vector<ProblemData::Client> const &clients)
+{
+    auto const numLocs = depots.size() + clients.size();
+    if (numLocs < RELABEL_MIN_LOCATIONS || matrix.numRows() != numLocs
+        || matrix.numCols() != numLocs)
+        return matrix;
+
+    if (matrix.isMapped() || matrix.metric() || matrix.isRelabelled())
+        return matrix;
+
+    matrix.relabel(spatialSlots(depots, clients));
+    return matrix;
+}
+
+// Returns the given matrix in compact, read-only storage. See
+// Matrix::compact().
+template <typename T> Matrix<T> compacted(Matrix<T> matrix)
+{
+    matrix.compact();
+    return matrix;
+}
+
+// As above, but the returned matrix shares the storage of the other matrix if
+// both store identical elements. Distance and duration matrices are often the
+// same, and then a single buffer serves both.
+template <typename T, typename U>
+Matrix<T> compacted(Matrix<T> matrix, Matrix<U> const &other)
+{
+    matrix.compact();
+    matrix.shareWith(other);
+    return matrix;
+}
 }  // namespace
 
 ProblemData::Client::Client(Coordinate x,
@@ -204,23 +528,23 @@ ProblemData::VehicleType::~VehicleType() { delete[] name; }
 
 std::vector<ProblemData::Client> const &ProblemData::clients() const
 {
-    return clients_;
+    return *clients_;
 }
 
 std::vector<ProblemData::Depot> const &ProblemData::depots() const
 {
-    return depots_;
+    return *depots_;
 }
 
 ProblemData::VehicleType const &
 ProblemData::vehicleType(size_t vehicleType) const
 {
-    return vehicleTypes_[vehicleType];
+    return (*vehicleTypes_)[vehicleType];
 }
 
 std::vector<ProblemData::VehicleType> const &ProblemData::vehicleTypes() const
 {
-    return vehicleTypes_;
+    return *vehicleTypes_;
 }
 
 Distance ProblemData::dist(size_t first, size_t second) const
@@ -238,16 +562,164 @@ std::pair<double, double> const &ProblemData::centroid() const
     return centroid_;
 }
 
-size_t ProblemData::numClients() const { return clients_.size(); }
+size_t ProblemData::numClients() const { return clients_->size(); }
 
-size_t ProblemData::numDepots() const { return depots_.size(); }
+size_t ProblemData::numDepots() const { return depots_->size(); }
 
 size_t ProblemData::numLocations() const { return numDepots() + numClients(); }
 
-size_t ProblemData::numVehicleTypes() const { return vehicleTypes_.size(); }
+size_t ProblemData::numVehicleTypes() const
+{
+    return vehicleTypes_->size();
+}
 
 size_t ProblemData::numVehicles() const { return numVehicles_; }
 
+Cost ProblemData::totalPrize() const { return totalPrize_; }
+
+bool ProblemData::hasTimeWindows() const { return hasTimeWindows_; }
+
+bool ProblemData::hasPickups() const { return hasPickups_; }
+
+bool ProblemData::hasReleaseTimes() const { return hasReleaseTimes_; }
+
+bool ProblemData::hasOptionalClients() const { return hasOptionalClients_; }
+
+std::string ProblemData::toBytes() const
+{
+    pyvrp::ByteWriter writer(pyvrp::PROBLEM_DATA_FORMAT);
+
+    writer.write<uint64_t>(numClients());
+    for (auto const &client : clients())
+    {
+        writer.write(client.x);
+        writer.write(client.y);
+        writer.write(client.delivery);
+        writer.write(client.pickup);
+        writer.write(client.serviceDuration);
+        writer.write(client.twEarly);
+        writer.write(client.twLate);
+        writer.write(client.releaseTime);
+        writer.write(client.prize);
+        writer.write(client.required);
+        writer.writeString(client.name);
+    }
+
+    writer.write<uint64_t>(numDepots());
+    for (auto const &depot : depots())
+    {
+        writer.write(depot.x);
+        writer.write(depot.y);
+        writer.write(depot.twEarly);
+        writer.write(depot.twLate);
+        writer.writeString(depot.name);
+    }
+
+    writer.write<uint64_t>(numVehicleTypes());
+    for (auto const &vehicleType : vehicleTypes())
+    {
+        writer.write<uint64_t>(vehicleType.numAvailable);
+        writer.write(vehicleType.capacity);
+        writer.write<uint64_t>(vehicleType.depot);
+        writer.write(vehicleType.fixedCost);
+        writer.write(vehicleType.twEarly);
+        writer.write(vehicleType.twLate);
+        writer.write(vehicleType.maxDuration);
+        writer.writeString(vehicleType.name);
+    }
+
+    writeMatrix(writer, dist_);
+    writeMatrix(writer, dur_);
+
+    return writer.release();
+}
+
+ProblemData ProblemData::fromBytes(std::string_view data)
+{
+    pyvrp::ByteReader reader(data, pyvrp::PROBLEM_DATA_FORMAT);
+
+    // The number of objects is not used to reserve memory up front, since
+    // it is not validated until the objects have actually been read.
+    std::vector<Client> clients;
+    auto const numClients = reader.read<uint64_t>();
+    for (size_t idx = 0; idx != numClients; ++idx)
+    {
+        auto const x = reader.read<pyvrp::Coordinate>();
+        auto const y = reader.read<pyvrp::Coordinate>();
+        auto const delivery = reader.read<pyvrp::Load>();
+        auto const pickup = reader.read<pyvrp::Load>();
+        auto const serviceDuration = reader.read<Duration>();
+        auto const twEarly = reader.read<Duration>();
+        auto const twLate = reader.read<Duration>();
+        auto const releaseTime = reader.read<Duration>();
+        auto const prize = reader.read<pyvrp::Cost>();
+        auto const required = reader.read<bool>();
+        auto const name = reader.readString();
+
+        clients.emplace_back(x,
+                             y,
+                             delivery,
+                             pickup,
+                             serviceDuration,
+                             twEarly,
+                             twLate,
+                             releaseTime,
+                             prize,
+                             required,
+                             name.c_str());
+    }
+
+    std::vector<Depot> depots;
+    auto const numDepots = reader.read<uint64_t>();
+    for (size_t idx = 0; idx != numDepots; ++idx)
+    {
+        auto const x = reader.read<pyvrp::Coordinate>();
+        auto const y = reader.read<pyvrp::Coordinate>();
+        auto const twEarly = reader.read<Duration>();
+        auto const twLate = reader.read<Duration>();
+        auto const name = reader.readString();
+
+        depots.emplace_back(x, y, twEarly, twLate, name.c_str());
+    }
+
+    std::vector<VehicleType> vehicleTypes;
+    auto const numVehicleTypes = reader.read<uint64_t>();
+    for (size_t idx = 0; idx != numVehicleTypes; ++idx)
+    {
+        auto const numAvailable = reader.read<uint64_t>();
+        auto const capacity = reader.read<pyvrp::Load>();
+        auto const depot = reader.read<uint64_t>();
+        auto const fixedCost = reader.read<pyvrp::Cost>();
+        auto const twEarly = reader.read<Duration>();
+        auto const twLate = reader.read<Duration>();
+        auto const maxDuration = reader.read<Duration>();
+        auto const name = reader.readString();
+
+        vehicleTypes.emplace_back(numAvailable,
+                                  capacity,
+                                  depot,
+                                  fixedCost,
+                                  twEarly,
+                                  twLate,
+                                  maxDuration,
+                                  name.c_str());
+    }
+
+    auto distMat = readMatrix<Distance>(reader);
+    auto durMat = readMatrix<Duration>(reader);
+    reader.finish();
+
+    ProblemData problemData(shared(std::move(clients)),
+                            shared(std::move(depots)),
+                            shared(std::move(vehicleTypes)),
+                            std::move(distMat),
+                            std::move(durMat));
+
+    checkDiagonal(problemData.dist_, "Distance matrix diagonal must be 0.");
+    checkDiagonal(problemData.dur_, "Duration matrix diagonal must be 0.");
+    return problemData;
+}
+
 ProblemData
 ProblemData::replace(std::optional<std::vector<Client>> &clients,
                      std::optional<std::vector<Depot>> &depots,
@@ -255,11 +727,25 @@ ProblemData::replace(std::optional<std::vector<Client>> &clients,
                      std::optional<Matrix<Distance>> &distMat,
                      std::optional<Matrix<Duration>> &durMat)
 {
-    return ProblemData(clients.value_or(clients_),
-                       depots.value_or(depots_),
-                       vehicleTypes.value_or(vehicleTypes_),
-                       distMat.value_or(dist_),
-                       durMat.value_or(dur_));
+    // Data that is not replaced is shared with this instance, rather than
+    // copied. The given data can be moved from, since it is not used again.
+    ProblemData problemData(clients ? shared(std::move(*clients)) : clients_,
+                            depots ? shared(std::move(*depots)) : depots_,
+                            vehicleTypes ? shared(std::move(*vehicleTypes))
+                                         : vehicleTypes_,
+                            distMat ? std::move(*distMat) : dist_,
+                            durMat ? std::move(*durMat) : dur_,
+                            clients || depots ? nullptr : attributes_);
+
+    // Only the diagonals of new matrices need checking: those of this
+    // instance's matrices have already been checked.
+    if (distMat)
+        checkDiagonal(problemData.dist_, "Distance matrix diagonal must be 0.");
+
+    if (durMat)
+        checkDiagonal(problemData.dur_, "Duration matrix diagonal must be 0.");
+
+    return problemData;
 }
 
 ProblemData::ProblemData(std::vector<Client> const &clients,
@@ -267,20 +753,66 @@ ProblemData::ProblemData(std::vector<Client> const &clients,
                          std::vector<VehicleType> const &vehicleTypes,
                          Matrix<Distance> distMat,
                          Matrix<Duration> durMat)
+    : ProblemData(shared(clients),
+                  shared(depots),
+                  shared(vehicleTypes),
+                  std::move(distMat),
+                  std::move(durMat))
+{
+    checkDiagonal(dist_, "Distance matrix diagonal must be 0.");
+    checkDiagonal(dur_, "Duration matrix diagonal must be 0.");
+}
+
+ProblemData::ProblemData(Shared<std::vector<Client>> clients,
+                         Shared<std::vector<Depot>> depots,
+                         Shared<std::vector<VehicleType>> vehicleTypes,
+                         Matrix<Distance> distMat,
+                         Matrix<Duration> durMat,
+                         Shared<LocationAttributes> attributes)
     : centroid_({0, 0}),
-      dist_(std::move(distMat)),
-      dur_(std::move(durMat)),
+      dist_(compacted(
+          relabelled(bound(std::move(distMat), *depots, *clients),
+                     *depots,
+                     *clients))),
+      dur_(compacted(relabelled(bound(std::move(durMat), *depots, *clients),
+                                *depots,
+                                *clients),
+                     dist_)),
       clients_(clients),
       depots_(depots),
       vehicleTypes_(vehicleTypes),
-      numVehicles_(std::accumulate(vehicleTypes.begin(),
-                                   vehicleTypes.end(),
+      attributes_(attributes ? attributes
+                             : shared(attributesOf(*depots, *clients))),
+      numVehicles_(std::accumulate(vehicleTypes->begin(),
+                                   vehicleTypes->end(),
                                    0,
                                    [](auto sum, VehicleType const &type) {
                                        return sum + type.numAvailable;
-                                   }))
+                                   })),
+      totalPrize_(std::accumulate(clients->begin(),
+                                  clients->end(),
+                                  Cost(0),
+                                  [](Cost sum, Client const &client) {
+                                      return sum + client.prize;
+                                  })),
+      hasTimeWindows_(anyTimeWindows(*clients, *depots, *vehicleTypes)),
+      hasPickups_(std::any_of(clients->begin(),
+                              clients->end(),
+                              [](auto const &client) {
+                                  return client.pickup > 0;
+                              })),
+      hasReleaseTimes_(std::any_of(clients->begin(),
+                                   clients->end(),
+                                   [](auto const &client) {
+                                       return client.releaseTime > 0;
+                                   })),
+      hasOptionalClients_(std::any_of(clients->begin(),
+                                      clients->end(),
+                                      [](auto const &client) {
+                                          return !client.required;
+                                      }))
 {
-    if (depots.empty())
+    if (depots_->empty())
         throw std::invalid_argument("Expected at least one depot!");
 
     if (dist_.numRows() != numLocations() || dist_.numCols() != numLocations())
@@ -291,16 +823,7 @@ ProblemData::ProblemData(std::vector<Client> const &clients,
         throw std::invalid_argument("Duration matrix shape does not match the "
                                     "problem size.");
 
-    for (size_t idx = 0; idx != numLocations(); ++idx)
-    {
-        if (dist_(idx, idx) != 0)
-            throw std::invalid_argument("Distance matrix diagonal must be 0.");
-
-        if (dur_(idx, idx) != 0)
-            throw std::invalid_argument("Duration matrix diagonal must be 0.");
-    }
-
-    for (auto const &client : clients_)
+    for (auto const &client : *clients_)
     {
         centroid_.first += static_cast<double>(client.x) / numClients();
         centroid_.second += static_cast<double>(client.y) / numClients();
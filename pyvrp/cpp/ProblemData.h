@@ -6,7 +6,10 @@
 
 #include <iosfwd>
 #include <limits>
+#include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace pyvrp
@@ -38,6 +41,31 @@ namespace pyvrp
  * duration_matrix
  *     A matrix that gives the travel times between clients (and the depot at
  *     index 0).
+ *
+ * .. note::
+ *
+ *    Instead of a matrix, the ``distance_matrix`` and ``duration_matrix``
+ *    arguments also accept the path of a matrix file written by
+ *    :func:`~write_matrix`. Such a file is memory-mapped rather than copied
+ *    into memory, which is useful for very large instances. For instances
+ *    that are too large for any matrix, a :class:`~Metric` can be passed
+ *    instead to compute distances and durations from the coordinates.
+ *
+ * .. note::
+ *
+ *    When the distance and duration matrices are identical, as is common,
+ *    both are backed by a single copy of the data. Matrices that cannot be
+ *    stored more compactly are not copied at all when they are passed in as
+ *    read-only numpy arrays: those arrays are then used directly. Writeable
+ *    arrays are always copied, since they may be modified afterwards.
+ *
+ * .. note::
+ *
+ *    Instances with at least 1,000 locations store the rows and columns of
+ *    their matrices ordered along a space-filling curve through the client
+ *    coordinates. Distances and durations between nearby clients are then
+ *    stored close together, which speeds up the search. This is invisible
+ *    from the outside: locations keep their indices.
  */
 class ProblemData
 {
@@ -304,6 +332,26 @@ public:
         ~VehicleType();
     };
 
+    /**
+     * Attributes of all locations, stored per attribute in contiguous arrays
+     * that are indexed by location: depots first, and then clients. Depots
+     * have no delivery, pickup, service duration, release time, or prize.
+     * Evaluation code that needs only a few attributes of each location
+     * should read them from these arrays, rather than through location().
+     */
+    struct LocationAttributes
+    {
+        std::vector<Coordinate> x;
+        std::vector<Coordinate> y;
+        std::vector<Load> delivery;
+        std::vector<Load> pickup;
+        std::vector<Duration> serviceDuration;
+        std::vector<Duration> twEarly;
+        std::vector<Duration> twLate;
+        std::vector<Duration> releaseTime;
+        std::vector<Cost> prize;
+    };
+
 private:
     /**
      * Simple union type that distinguishes between client and depot locations.
@@ -317,16 +365,33 @@ private:
         inline operator Depot const &() const;
     };
 
-    std::pair<double, double> centroid_;           // Center of client locations
-    Matrix<Distance> const dist_;                  // Distance matrix
-    Matrix<Duration> const dur_;                   // Duration matrix
-    std::vector<Client> const clients_;            // Client information
-    std::vector<Depot> const depots_;              // Depot information
-    std::vector<VehicleType> const vehicleTypes_;  // Vehicle type information
+    // Immutable data that is shared between instances, so that replace()
+    // copies only what is replaced.
+    template <typename T> using Shared = std::shared_ptr<T const>;
+
+    std::pair<double, double> centroid_;  // Center of client locations
+    Matrix<Distance> const dist_;         // Distance matrix
+    Matrix<Duration> const dur_;          // Duration matrix
+
+    Shared<std::vector<Client>> const clients_;  // Client information
+    Shared<std::vector<Depot>> const depots_;    // Depot information
+    Shared<std::vector<VehicleType>> const vehicleTypes_;  // Vehicle types
+    Shared<LocationAttributes> const attributes_;  // Location attributes
 
     size_t const numVehicles_;
+    Cost const totalPrize_;  // Sum of all client prizes
+
+    bool const hasTimeWindows_;      // Can any route ever incur time warp?
+    bool const hasPickups_;          // Does any client have a pickup amount?
+    bool const hasReleaseTimes_;     // Does any client have a release time?
+    bool const hasOptionalClients_;  // Is any client not required?
 
 public:
+    /**
+     * Returns the attributes of all locations, stored per attribute.
+     */
+    [[nodiscard]] inline LocationAttributes const &attributes() const;
+
     /**
      * Returns location data for the location at the given index. This can
      * be a depot or a client: a depot if the ``idx`` argument is smaller than
@@ -441,9 +506,16 @@ public:
      *
      * .. note::
      *
-     *    This method returns a read-only view of the underlying data. No
-     *    matrix is copied, but the resulting data cannot be modified in any
-     *    way!
+     *    This method returns a read-only view of the underlying data, which
+     *    cannot be modified in any way! Matrices that are stored as a full
+     *    array of values are not copied. Integer matrices are stored using
+     *    the narrowest of 16, 32, or 64-bit integers that fits all values,
+     *    symmetric matrices store only their lower triangle, large instances
+     *    store their rows and columns in a different order, and matrices
+     *    computed by a :class:`~Metric` store no data at all. Those are
+     *    unpacked into a new full matrix on each call, which this instance
+     *    does not keep. Use :meth:`~dist` or :meth:`~duration` to look up a
+     *    few values without unpacking the full matrix.
      */
     [[nodiscard]] inline Matrix<Distance> const &distanceMatrix() const;
 
@@ -452,9 +524,16 @@ public:
      *
      * .. note::
      *
-     *    This method returns a read-only view of the underlying data. No
-     *    matrix is copied, but the resulting data cannot be modified in any
-     *    way!
+     *    This method returns a read-only view of the underlying data, which
+     *    cannot be modified in any way! Matrices that are stored as a full
+     *    array of values are not copied. Integer matrices are stored using
+     *    the narrowest of 16, 32, or 64-bit integers that fits all values,
+     *    symmetric matrices store only their lower triangle, large instances
+     *    store their rows and columns in a different order, and matrices
+     *    computed by a :class:`~Metric` store no data at all. Those are
+     *    unpacked into a new full matrix on each call, which this instance
+     *    does not keep. Use :meth:`~dist` or :meth:`~duration` to look up a
+     *    few values without unpacking the full matrix.
      */
     [[nodiscard]] inline Matrix<Duration> const &durationMatrix() const;
 
@@ -509,6 +588,86 @@ public:
      */
     [[nodiscard]] size_t numVehicles() const;
 
+    // Total prize value of all clients in this problem instance.
+    [[nodiscard]] Cost totalPrize() const;
+
+    /**
+     * Whether this problem instance has time constraints, that is, whether
+     * any client, depot, or vehicle type has a time window that closes, or
+     * any vehicle type has a maximum route duration. When this is not the
+     * case, no route can ever incur time warp.
+     *
+     * Returns
+     * -------
+     * bool
+     *     True if the instance has time windows or maximum route durations.
+     */
+    [[nodiscard]] bool hasTimeWindows() const;
+
+    /**
+     * Whether any client in this problem instance has a pickup amount.
+     *
+     * Returns
+     * -------
+     * bool
+     *     True if any client has a positive pickup amount.
+     */
+    [[nodiscard]] bool hasPickups() const;
+
+    /**
+     * Whether any client in this problem instance has a release time.
+     *
+     * Returns
+     * -------
+     * bool
+     *     True if any client has a positive release time.
+     */
+    [[nodiscard]] bool hasReleaseTimes() const;
+
+    /**
+     * Whether this problem instance has clients that are not required, that
+     * is, whether this is a prize-collecting instance.
+     *
+     * Returns
+     * -------
+     * bool
+     *     True if any client is optional.
+     */
+    [[nodiscard]] bool hasOptionalClients() const;
+
+    /**
+     * Returns a compact binary representation of this problem instance.
+     *
+     * Returns
+     * -------
+     * bytes
+     *     Binary representation of this problem instance.
+     */
+    [[nodiscard]] std::string toBytes() const;
+
+    /**
+     * from_bytes(data: bytes) -> ProblemData
+     *
+     * Reconstructs a problem instance from its binary representation, as
+     * returned by :meth:`~to_bytes`.
+     *
+     * Parameters
+     * ----------
+     * data
+     *     Binary representation of a problem instance.
+     *
+     * Returns
+     * -------
+     * ProblemData
+     *     The reconstructed problem instance.
+     *
+     * Raises
+     * ------
+     * ValueError
+     *     When the given data does not describe a problem instance.
+     */
+    static ProblemData fromBytes(std::string_view data);
+
     /**
      * Returns a new ProblemData instance with the same data as this instance,
      * except for the given parameters, which are used instead.
@@ -553,18 +712,32 @@ public:
                 std::vector<VehicleType> const &vehicleTypes,
                 Matrix<Distance> distMat,
                 Matrix<Duration> durMat);
+
+private:
+    ProblemData(Shared<std::vector<Client>> clients,
+                Shared<std::vector<Depot>> depots,
+                Shared<std::vector<VehicleType>> vehicleTypes,
+                Matrix<Distance> distMat,
+                Matrix<Duration> durMat,
+                Shared<LocationAttributes> attributes = nullptr);
 };
 
 ProblemData::Location::operator Client const &() const { return *client; }
 
 ProblemData::Location::operator Depot const &() const { return *depot; }
 
+ProblemData::LocationAttributes const &ProblemData::attributes() const
+{
+    return *attributes_;
+}
+
 ProblemData::Location ProblemData::location(size_t idx) const
 {
     assert(idx < numLocations());
-    return idx < depots_.size()
-               ? Location{.depot = &depots_[idx]}
-               : Location{.client = &clients_[idx - depots_.size()]};
+    auto const &depots = *depots_;
+    return idx < depots.size()
+               ? Location{.depot = &depots[idx]}
+               : Location{.client = &(*clients_)[idx - depots.size()]};
 }
 
 Matrix<Distance> const &ProblemData::distanceMatrix() const { return dist_; }
@@ -1,9 +1,11 @@
 #include "Solution.h"
+#include "Bytes.h"
 #include "DurationSegment.h"
 #include "LoadSegment.h"
 #include "ProblemData.h"
 
 #include <fstream>
+#include <mutex>
 #include <numeric>
 #include <unordered_map>
 
@@ -12,18 +14,94 @@ using pyvrp::Distance;
 using pyvrp::Duration;
 using pyvrp::Load;
 using pyvrp::Solution;
+using pyvrp::Value;
 
 using Client = size_t;
 using Visits = std::vector<Client>;
 using Routes = std::vector<Solution::Route>;
 using Neighbours = std::vector<std::optional<std::pair<Client, Client>>>;
 
-void Solution::evaluate(ProblemData const &data)
+namespace
+{
+// Mixes the bits of the given value, using the splitmix64 finaliser.
+uint64_t mix(uint64_t value)
+{
+    value += 0x9e3779b97f4a7c15;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+    return value ^ (value >> 31);
+}
+
+void writeRoute(pyvrp::ByteWriter &writer, Solution::Route const &route)
 {
-    Cost allPrizes = 0;
-    for (auto const &client : data.clients())
-        allPrizes += client.prize;
+    writer.write<uint64_t>(route.size());
+    for (auto const client : route)
+        writer.write(static_cast<uint32_t>(client));
+
+    writer.write(route.distance());
+    writer.write(route.delivery());
+    writer.write(route.pickup());
+    writer.write(route.excessLoad());
+    writer.write(route.duration());
+    writer.write(route.timeWarp());
+    writer.write(route.travelDuration());
+    writer.write(route.serviceDuration());
+    writer.write(route.waitDuration());
+    writer.write(route.releaseTime());
+    writer.write(route.startTime());
+    writer.write(route.slack());
+    writer.write(route.prizes());
+    writer.write(route.centroid().first);
+    writer.write(route.centroid().second);
+    writer.write<uint64_t>(route.vehicleType());
+    writer.write<uint64_t>(route.depot());
+}
+
+Solution::Route readRoute(pyvrp::ByteReader &reader)
+{
+    auto const packed = reader.readArray<uint32_t>(reader.read<uint64_t>());
+    Visits visits(packed.begin(), packed.end());
+
+    auto const distance = reader.read<Distance>();
+    auto const delivery = reader.read<Load>();
+    auto const pickup = reader.read<Load>();
+    auto const excessLoad = reader.read<Load>();
+    auto const duration = reader.read<Duration>();
+    auto const timeWarp = reader.read<Duration>();
+    auto const travel = reader.read<Duration>();
+    auto const service = reader.read<Duration>();
+    auto const wait = reader.read<Duration>();
+    auto const release = reader.read<Duration>();
+    auto const startTime = reader.read<Duration>();
+    auto const slack = reader.read<Duration>();
+    auto const prizes = reader.read<Cost>();
+    auto const centroidX = reader.read<double>();
+    auto const centroidY = reader.read<double>();
+    auto const vehicleType = reader.read<uint64_t>();
+    auto const depot = reader.read<uint64_t>();
+
+    return {std::move(visits),
+            distance,
+            delivery,
+            pickup,
+            excessLoad,
+            duration,
+            timeWarp,
+            travel,
+            service,
+            wait,
+            release,
+            startTime,
+            slack,
+            prizes,
+            {centroidX, centroidY},
+            vehicleType,
+            depot};
+}
+}  // namespace
 
+void Solution::evaluate(ProblemData const &data)
+{
     for (auto const &route : routes_)
     {
         // Whole solution statistics.
@@ -35,7 +113,7 @@ void Solution::evaluate(ProblemData const &data)
         fixedVehicleCost_ += data.vehicleType(route.vehicleType()).fixedCost;
     }
 
-    uncollectedPrizes_ = allPrizes - prizes_;
+    uncollectedPrizes_ = data.totalPrize() - prizes_;
 }
 
 bool Solution::empty() const { return numClients() == 0 && numRoutes() == 0; }
@@ -48,7 +126,36 @@ size_t Solution::numMissingClients() const { return numMissingClients_; }
 
 Routes const &Solution::getRoutes() const { return routes_; }
 
-Neighbours const &Solution::getNeighbours() const { return neighbours_; }
+Neighbours Solution::getNeighbours() const
+{
+    auto const preds = predecessors();
+    auto const succs = successors();
+
+    Neighbours neighbours(preds.size(), std::nullopt);
+    for (size_t idx = 0; idx != preds.size(); ++idx)
+        if (preds[idx] != UNASSIGNED)
+            neighbours[idx] = {preds[idx], succs[idx]};
+
+    return neighbours;
+}
+
+std::span<uint32_t const> Solution::predecessors() const
+{
+    return {neighbours_.data(), neighbours_.size() / 2};
+}
+
+std::span<uint32_t const> Solution::successors() const
+{
+    auto const numLocations = neighbours_.size() / 2;
+    return {neighbours_.data() + numLocations, numLocations};
+}
+
+size_t Solution::hash() const { return hash_; }
+
+std::vector<uint64_t> const &Solution::sketch() const
+{
+    return sketch_.get(*this);
+}
 
 bool Solution::isFeasible() const
 {
@@ -73,23 +180,172 @@ Cost Solution::uncollectedPrizes() const { return uncollectedPrizes_; }
 
 Duration Solution::timeWarp() const { return timeWarp_; }
 
-void Solution::makeNeighbours(ProblemData const &data)
+void Solution::makeNeighbours()
+{
+    auto *preds = neighbours_.data();
+    auto *succs = neighbours_.data() + neighbours_.size() / 2;
+
+    for (auto const &route : routes_)
+    {
+        auto const depot = route.depot();
+
+        for (size_t idx = 0; idx != route.size(); ++idx)
+        {
+            auto const pred = idx == 0 ? depot : route[idx - 1];
+            auto const succ = idx == route.size() - 1 ? depot : route[idx + 1];
+
+            preds[route[idx]] = static_cast<uint32_t>(pred);
+            succs[route[idx]] = static_cast<uint32_t>(succ);
+        }
+    }
+
+    makeHash();
+}
+
+void Solution::makeHash()
 {
+    // Zobrist-style hash: each client contributes a pseudo-random key based
+    // on its (pred, succ) pair and vehicle type. These keys are summed, so the
+    // result does not depend on the order in which the routes are stored.
+    uint64_t hash = 0;
     for (auto const &route : routes_)
     {
-        auto const depot = data.vehicleType(route.vehicleType()).depot;
+        auto const depot = route.depot();
+        auto const vehType = route.vehicleType();
 
         for (size_t idx = 0; idx != route.size(); ++idx)
-            neighbours_[route[idx]]
-                = {idx == 0 ? depot : route[idx - 1],                  // pred
-                   idx == route.size() - 1 ? depot : route[idx + 1]};  // succ
+        {
+            auto const pred = idx == 0 ? depot : route[idx - 1];
+            auto const succ = idx == route.size() - 1 ? depot : route[idx + 1];
+
+            auto key = mix(route[idx]);
+            key = mix(key ^ pred);
+            key = mix(key ^ succ);
+            hash += mix(key ^ vehType);
+        }
+    }
+
+    hash_ = static_cast<size_t>(hash);
+}
+
+void Solution::makeSketch(std::vector<uint64_t> &sketch) const
+{
+    size_t numVisits = 0;
+    for (auto const &route : routes_)
+        numVisits += route.size();
+
+    // Each client contributes two elements: its (pred, client) pair, and its
+    // (client, succ) pair. The lowest bit distinguishes the two, so they are
+    // distinct even when they describe the same edge.
+    auto const numElements = 2 * numVisits;
+    auto const hashElements = [&](auto &&consume) {
+        for (auto const &route : routes_)
+        {
+            uint64_t const depot = route.depot();
+            for (size_t idx = 0; idx != route.size(); ++idx)
+            {
+                uint64_t const client = route[idx];
+                uint64_t const pred = idx == 0 ? depot : route[idx - 1];
+                uint64_t const succ
+                    = idx == route.size() - 1 ? depot : route[idx + 1];
+
+                consume(mix((client << 33) | (pred << 1)));
+                consume(mix((client << 33) | (succ << 1) | 1));
+            }
+        }
+    };
+
+    // Hash values are roughly uniform, so we expect only a few times
+    // SKETCH_SIZE values below this threshold. Only those are candidates for
+    // the sketch. In the unlikely case there are too few, we try again with a
+    // larger threshold.
+    auto const max = std::numeric_limits<uint64_t>::max();
+    auto const fraction = 4.0 * SKETCH_SIZE / std::max<size_t>(numElements, 1);
+    auto threshold = max;
+    if (fraction < 1)
+        threshold = static_cast<uint64_t>(fraction * max);
+
+    // Candidates are collected in a scratch buffer that is reused between
+    // calls, so only the final sketch needs to be allocated.
+    thread_local std::vector<uint64_t> candidates;
+
+    candidates.clear();
+    while (true)
+    {
+        hashElements([&](uint64_t hash) {
+            if (hash <= threshold)
+                candidates.push_back(hash);
+        });
+
+        if (candidates.size() >= std::min(numElements, SKETCH_SIZE))
+            break;
+
+        candidates.clear();
+        threshold = threshold > max / 2 ? max : 2 * threshold;
     }
+
+    auto const size = std::min(candidates.size(), SKETCH_SIZE);
+    auto const last = candidates.begin() + size;
+    std::nth_element(candidates.begin(), last, candidates.end());
+    std::sort(candidates.begin(), last);
+    sketch.assign(candidates.begin(), last);
+}
+
+Solution::LazySketch::LazySketch(LazySketch const &other) { *this = other; }
+
+Solution::LazySketch::LazySketch(LazySketch &&other)
+{
+    *this = std::move(other);
+}
+
+Solution::LazySketch &
+Solution::LazySketch::operator=(LazySketch const &other)
+{
+    // The other sketch may be computed concurrently, but once it is ready it
+    // no longer changes. Until then we consider it not computed. This object
+    // itself is not accessed by other threads while it is being assigned to.
+    auto const ready = other.ready_.load(std::memory_order_acquire);
+    if (ready && this != &other)
+        values_ = other.values_;
+
+    ready_.store(ready, std::memory_order_relaxed);
+    return *this;
+}
+
+Solution::LazySketch &Solution::LazySketch::operator=(LazySketch &&other)
+{
+    auto const ready = other.ready_.load(std::memory_order_acquire);
+    if (ready && this != &other)
+    {
+        values_ = std::move(other.values_);
+        other.ready_.store(false, std::memory_order_relaxed);
+    }
+
+    ready_.store(ready, std::memory_order_relaxed);
+    return *this;
+}
+
+std::vector<uint64_t> const &
+Solution::LazySketch::get(Solution const &solution) const
+{
+    if (!ready_.load(std::memory_order_acquire))
+    {
+        std::lock_guard const lock(mutex_);
+        if (!ready_.load(std::memory_order_relaxed))
+        {
+            solution.makeSketch(values_);
+            ready_.store(true, std::memory_order_release);
+        }
+    }
+
+    return values_;
 }
 
 bool Solution::operator==(Solution const &other) const
 {
     // First compare simple attributes, since that's quick and cheap.
-    bool const simpleChecks = distance_ == other.distance_
+    bool const simpleChecks = hash_ == other.hash_
+                              && distance_ == other.distance_
                               && excessLoad_ == other.excessLoad_
                               && timeWarp_ == other.timeWarp_
                               && routes_.size() == other.routes_.size();
@@ -103,22 +359,125 @@ bool Solution::operator==(Solution const &other) const
         return false;
 
     // The visits are the same for both solutions, but the vehicle assignments
-    // need not be. We check this via a mapping from the first client in each
-    // route to the vehicle type of that route. We need to base this on the
-    // visits since the routes need not be in the same order between solutions.
-    std::unordered_map<Client, VehicleType> client2vehType;
-    for (auto const &route : routes_)
-        client2vehType[route.visits()[0]] = route.vehicleType();
+    // need not be. We check this by matching each route in the other solution
+    // to the route in this solution that starts with the same client. Routes
+    // are often stored in the same order, so we start looking at the route
+    // with the same index, and wrap around if that route does not match.
+    auto const numRoutes = routes_.size();
+    for (size_t idx = 0; idx != numRoutes; ++idx)
+    {
+        auto const &route = other.routes_[idx];
+        if (route.empty())
+            continue;
 
-    for (auto const &route : other.routes_)
-        if (client2vehType[route.visits()[0]] != route.vehicleType())
+        auto jdx = idx;
+        for (size_t count = 0; count != numRoutes; ++count)
+        {
+            auto const &candidate = routes_[jdx];
+            if (!candidate.empty() && candidate[0] == route[0])
+                break;
+
+            jdx = jdx + 1 == numRoutes ? 0 : jdx + 1;
+        }
+
+        if (routes_[jdx].empty() || routes_[jdx][0] != route[0]
+            || routes_[jdx].vehicleType() != route.vehicleType())
             return false;
+    }
 
     return true;
 }
 
+std::string Solution::toBytes() const
+{
+    pyvrp::ByteWriter writer(pyvrp::SOLUTION_FORMAT);
+
+    writer.write<uint64_t>(numClients_);
+    writer.write<uint64_t>(numMissingClients_);
+    writer.write(distance_);
+    writer.write(excessLoad_);
+    writer.write(fixedVehicleCost_);
+    writer.write(prizes_);
+    writer.write(uncollectedPrizes_);
+    writer.write(timeWarp_);
+    writer.write<uint64_t>(predecessors().size());
+    writer.writeArray(neighbours_.data(), neighbours_.size());
+
+    writer.write<uint64_t>(routes_.size());
+    for (auto const &route : routes_)
+        writeRoute(writer, route);
+
+    return writer.release();
+}
+
+Solution Solution::fromBytes(std::string_view data)
+{
+    pyvrp::ByteReader reader(data, pyvrp::SOLUTION_FORMAT);
+
+    auto const numClients = reader.read<uint64_t>();
+    auto const numMissingClients = reader.read<uint64_t>();
+    auto const distance = reader.read<Distance>();
+    auto const excessLoad = reader.read<Load>();
+    auto const fixedVehicleCost = reader.read<Cost>();
+    auto const prizes = reader.read<Cost>();
+    auto const uncollectedPrizes = reader.read<Cost>();
+    auto const timeWarp = reader.read<Duration>();
+    auto const numLocations = reader.read<uint64_t>();
+
+    // The packed neighbours are part of the data, so the number of locations
+    // is validated against the remaining data before anything is allocated
+    // for it.
+    if (numLocations > std::numeric_limits<uint64_t>::max() / 2)
+        throw std::invalid_argument("Invalid number of locations.");
+
+    auto const neighbours = reader.readArray<uint32_t>(2 * numLocations);
+
+    Routes routes;
+    auto const numRoutes = reader.read<uint64_t>();
+    for (size_t idx = 0; idx != numRoutes; ++idx)
+        routes.push_back(readRoute(reader));
+
+    reader.finish();
+
+    for (auto const &route : routes)
+        for (auto const client : route)
+            if (client >= numLocations)
+                throw std::invalid_argument("Route visits unknown location.");
+
+    Solution solution(numClients,
+                      numMissingClients,
+                      distance,
+                      excessLoad,
+                      fixedVehicleCost,
+                      prizes,
+                      uncollectedPrizes,
+                      timeWarp,
+                      routes,
+                      numLocations);
+
+    if (solution.neighbours_ != neighbours)
+        throw std::invalid_argument("Neighbours do not match routes.");
+
+    return solution;
+}
+
+std::string Solution::Route::toBytes() const
+{
+    pyvrp::ByteWriter writer(pyvrp::ROUTE_FORMAT);
+    writeRoute(writer, *this);
+    return writer.release();
+}
+
+Solution::Route Solution::Route::fromBytes(std::string_view data)
+{
+    pyvrp::ByteReader reader(data, pyvrp::ROUTE_FORMAT);
+    auto route = readRoute(reader);
+    reader.finish();
+    return route;
+}
+
 Solution::Solution(ProblemData const &data, RandomNumberGenerator &rng)
-    : neighbours_(data.numLocations(), std::nullopt)
+    : neighbours_(2 * data.numLocations(), UNASSIGNED)
 {
     // Shuffle clients (to create random routes)
     auto clients = std::vector<size_t>(data.numClients());
@@ -150,7 +509,7 @@ Solution::Solution(ProblemData const &data, RandomNumberGenerator &rng)
                 routes_.emplace_back(data, routes[count++], vehType);
     }
 
-    makeNeighbours(data);
+    makeNeighbours();
     evaluate(data);
 }
 
@@ -166,7 +525,7 @@ Solution::Solution(ProblemData const &data,
 }
 
 Solution::Solution(ProblemData const &data, std::vector<Route> const &routes)
-    : routes_(routes), neighbours_(data.numLocations(), std::nullopt)
+    : routes_(routes), neighbours_(2 * data.numLocations(), UNASSIGNED)
 {
     if (routes.size() > data.numVehicles())
     {
@@ -174,8 +533,14 @@ Solution::Solution(ProblemData const &data, std::vector<Route> const &routes)
         throw std::runtime_error(msg);
     }
 
-    std::vector<size_t> visits(data.numLocations(), 0);
-    std::vector<size_t> usedVehicles(data.numVehicleTypes(), 0);
+    // Scratch buffers for counting visits and used vehicles. These are reused
+    // between calls, so validation does not allocate once they are large
+    // enough.
+    thread_local std::vector<size_t> visits;
+    thread_local std::vector<size_t> usedVehicles;
+
+    visits.assign(data.numLocations(), 0);
+    usedVehicles.assign(data.numVehicleTypes(), 0);
     for (auto const &route : routes)
     {
         if (route.empty())
@@ -211,7 +576,7 @@ Solution::Solution(ProblemData const &data, std::vector<Route> const &routes)
             throw std::runtime_error(msg.str());
         }
 
-    makeNeighbours(data);
+    makeNeighbours();
     evaluate(data);
 }
 
@@ -224,7 +589,7 @@ Solution::Solution(size_t numClients,
                    Cost uncollectedPrizes,
                    Duration timeWarp,
                    Routes const &routes,
-                   Neighbours neighbours)
+                   size_t numLocations)
     : numClients_(numClients),
       numMissingClients_(numMissingClients),
       distance_(distance),
@@ -234,26 +599,104 @@ Solution::Solution(size_t numClients,
       uncollectedPrizes_(uncollectedPrizes),
       timeWarp_(timeWarp),
       routes_(routes),
-      neighbours_(neighbours)
+      neighbours_(2 * numLocations, UNASSIGNED)
 {
+    makeNeighbours();
+}
+
+struct Solution::Route::Data
+{
+    Visits visits = {};      // Client visits on this route
+    Distance distance = 0;   // Total travel distance on this route
+    Load delivery = 0;       // Total delivery amount served on this route
+    Load pickup = 0;         // Total pickup amount gathered on this route
+    Load excessLoad = 0;     // Excess pickup or delivery demand
+    Duration duration = 0;   // Total duration of this route
+    Duration timeWarp = 0;   // Total time warp on this route
+    Duration travel = 0;     // Total *travel* duration on this route
+    Duration service = 0;    // Total *service* duration on this route
+    Duration wait = 0;       // Total *waiting* duration on this route
+    Duration release = 0;    // Release time of this route
+    Duration startTime = 0;  // (earliest) start time of this route
+    Duration slack = 0;      // Total time slack on this route
+    Cost prizes = 0;         // Total value of prizes on this route
+
+    std::pair<double, double> centroid = {0, 0};  // Route center
+    VehicleType vehicleType = 0;                  // Type of vehicle
+    Depot depot = 0;                              // Assigned depot
+
+    bool operator==(Data const &other) const = default;
+
+    // Hash of the route's visits, vehicle type and distance. This is a cheap
+    // proxy for the full route data, which is compared on collisions.
+    [[nodiscard]] size_t hash() const;
+};
+
+size_t Solution::Route::Data::hash() const
+{
+    uint64_t hash = mix(vehicleType);
+    for (auto const client : visits)
+        hash = mix(hash ^ client);
+
+    return static_cast<size_t>(hash ^ std::hash<Value>()(distance.get()));
+}
+
+void Solution::shareRoutes(RouteTable &table)
+{
+    // Entries whose data has expired are swept out once the table has grown
+    // to twice its size after the previous sweep. That keeps the table small
+    // while amortising the cost of each sweep over many insertions.
+    if (table.data.size() >= table.sweepSize)
+    {
+        auto const isExpired = [](auto const &kv) {
+            return kv.second.expired();
+        };
+
+        std::erase_if(table.data, isExpired);
+        table.sweepSize = std::max<size_t>(2 * table.data.size(), 1024);
+    }
+
+    for (auto &route : routes_)
+    {
+        auto const &data = *route.data_;
+        auto const hash = data.hash();
+        auto const [first, last] = table.data.equal_range(hash);
+
+        auto it = first;
+        for (; it != last; ++it)
+            if (auto shared = it->second.lock(); shared && *shared == data)
+            {
+                route.data_ = std::move(shared);  // data is not used after this
+                break;
+            }
+
+        if (it == last)
+            table.data.emplace(hash, route.data_);
+    }
 }
 
 Solution::Route::Route(ProblemData const &data,
                        Visits visits,
                        size_t const vehicleType)
-    : visits_(std::move(visits)), centroid_({0, 0}), vehicleType_(vehicleType)
 {
     auto const &vehType = data.vehicleType(vehicleType);
-    depot_ = vehType.depot;
 
-    if (visits_.empty())
+    Data route;
+    route.visits = std::move(visits);
+    route.vehicleType = vehicleType;
+    route.depot = vehType.depot;
+
+    if (route.visits.empty())
+    {
+        data_ = std::make_shared<Data const>(std::move(route));
         return;
+    }
 
     // Time window is limited by both the depot open and closing times, and
     // the vehicle's start and end of shift, whichever is tighter.
-    ProblemData::Depot const &depotLocation = data.location(depot_);
-    DurationSegment depotDS(depot_,
-                            depot_,
+    ProblemData::Depot const &depotLocation = data.location(route.depot);
+    DurationSegment depotDS(route.depot,
+                            route.depot,
                             0,
                             0,
                             std::max(depotLocation.twEarly, vehType.twEarly),
@@ -263,43 +706,44 @@ Solution::Route::Route(ProblemData const &data,
     auto ds = depotDS;
     auto ls = LoadSegment(0, 0, 0);
     size_t prevClient = vehType.depot;
+    auto const size = route.visits.size();
 
-    for (size_t idx = 0; idx != size(); ++idx)
+    auto const &attrs = data.attributes();
+    for (auto const client : route.visits)
     {
-        auto const client = visits_[idx];
-        ProblemData::Client const &clientData = data.location(client);
+        route.distance += data.dist(prevClient, client);
+        route.travel += data.duration(prevClient, client);
+        route.service += attrs.serviceDuration[client];
+        route.prizes += attrs.prize[client];
 
-        distance_ += data.dist(prevClient, client);
-        travel_ += data.duration(prevClient, client);
-        service_ += clientData.serviceDuration;
-        prizes_ += clientData.prize;
+        route.centroid.first += static_cast<double>(attrs.x[client]) / size;
+        route.centroid.second += static_cast<double>(attrs.y[client]) / size;
 
-        centroid_.first += static_cast<double>(clientData.x) / size();
-        centroid_.second += static_cast<double>(clientData.y) / size();
-
-        auto const clientDS = DurationSegment(client, clientData);
+        auto const clientDS = DurationSegment(data, client);
         ds = DurationSegment::merge(data.durationMatrix(), ds, clientDS);
 
-        auto const clientLs = LoadSegment(clientData);
+        auto const clientLs = LoadSegment(data, client);
         ls = LoadSegment::merge(ls, clientLs);
 
         prevClient = client;
     }
 
-    Client const last = visits_.back();  // last client has depot as successor
-    distance_ += data.dist(last, vehType.depot);
-    travel_ += data.duration(last, vehType.depot);
+    Client const last = route.visits.back();  // last client has depot as succ
+    route.distance += data.dist(last, vehType.depot);
+    route.travel += data.duration(last, vehType.depot);
 
-    delivery_ = ls.delivery();
-    pickup_ = ls.pickup();
-    excessLoad_ = std::max<Load>(ls.load() - vehType.capacity, 0);
+    route.delivery = ls.delivery();
+    route.pickup = ls.pickup();
+    route.excessLoad = std::max<Load>(ls.load() - vehType.capacity, 0);
 
     ds = DurationSegment::merge(data.durationMatrix(), ds, depotDS);
-    duration_ = ds.duration();
-    startTime_ = ds.twEarly();
-    slack_ = ds.twLate() - ds.twEarly();
-    timeWarp_ = ds.timeWarp(vehType.maxDuration);
-    release_ = ds.releaseTime();
+    route.duration = ds.duration();
+    route.startTime = ds.twEarly();
+    route.slack = ds.twLate() - ds.twEarly();
+    route.timeWarp = ds.timeWarp(vehType.maxDuration);
+    route.release = ds.releaseTime();
+
+    data_ = std::make_shared<Data const>(std::move(route));
 }
 
 Solution::Route::Route(Visits visits,
@@ -319,104 +763,119 @@ Solution::Route::Route(Visits visits,
                        std::pair<double, double> centroid,
                        size_t vehicleType,
                        size_t depot)
-    : visits_(std::move(visits)),
-      distance_(distance),
-      delivery_(delivery),
-      pickup_(pickup),
-      excessLoad_(excessLoad),
-      duration_(duration),
-      timeWarp_(timeWarp),
-      travel_(travel),
-      service_(service),
-      wait_(wait),
-      release_(release),
-      startTime_(startTime),
-      slack_(slack),
-      prizes_(prizes),
-      centroid_(centroid),
-      vehicleType_(vehicleType),
-      depot_(depot)
+    : data_(std::make_shared<Data const>(Data{std::move(visits),
+                                              distance,
+                                              delivery,
+                                              pickup,
+                                              excessLoad,
+                                              duration,
+                                              timeWarp,
+                                              travel,
+                                              service,
+                                              wait,
+                                              release,
+                                              startTime,
+                                              slack,
+                                              prizes,
+                                              centroid,
+                                              vehicleType,
+                                              depot}))
 {
 }
 
-bool Solution::Route::empty() const { return visits_.empty(); }
+bool Solution::Route::empty() const { return data_->visits.empty(); }
 
-size_t Solution::Route::size() const { return visits_.size(); }
+size_t Solution::Route::size() const { return data_->visits.size(); }
 
-Client Solution::Route::operator[](size_t idx) const { return visits_[idx]; }
+Client Solution::Route::operator[](size_t idx) const
+{
+    return data_->visits[idx];
+}
 
 Visits::const_iterator Solution::Route::begin() const
 {
-    return visits_.cbegin();
+    return data_->visits.cbegin();
 }
 
-Visits::const_iterator Solution::Route::end() const { return visits_.cend(); }
+Visits::const_iterator Solution::Route::end() const
+{
+    return data_->visits.cend();
+}
 
-Visits const &Solution::Route::visits() const { return visits_; }
+Visits const &Solution::Route::visits() const { return data_->visits; }
 
-Distance Solution::Route::distance() const { return distance_; }
+Distance Solution::Route::distance() const { return data_->distance; }
 
-Load Solution::Route::delivery() const { return delivery_; }
+Load Solution::Route::delivery() const { return data_->delivery; }
 
-Load Solution::Route::pickup() const { return pickup_; }
+Load Solution::Route::pickup() const { return data_->pickup; }
 
-Load Solution::Route::excessLoad() const { return excessLoad_; }
+Load Solution::Route::excessLoad() const { return data_->excessLoad; }
 
-Duration Solution::Route::duration() const { return duration_; }
+Duration Solution::Route::duration() const { return data_->duration; }
 
-Duration Solution::Route::serviceDuration() const { return service_; }
+Duration Solution::Route::serviceDuration() const { return data_->service; }
 
-Duration Solution::Route::timeWarp() const { return timeWarp_; }
+Duration Solution::Route::timeWarp() const { return data_->timeWarp; }
 
 Duration Solution::Route::waitDuration() const
 {
-    return duration_ - travel_ - service_;
+    return data_->duration - data_->travel - data_->service;
 }
 
-Duration Solution::Route::travelDuration() const { return travel_; }
+Duration Solution::Route::travelDuration() const { return data_->travel; }
 
-Duration Solution::Route::startTime() const { return startTime_; }
+Duration Solution::Route::startTime() const { return data_->startTime; }
 
 Duration Solution::Route::endTime() const
 {
-    return startTime_ + duration_ - timeWarp_;
+    return data_->startTime + data_->duration - data_->timeWarp;
 }
 
-Duration Solution::Route::slack() const { return slack_; }
+Duration Solution::Route::slack() const { return data_->slack; }
 
-Duration Solution::Route::releaseTime() const { return release_; }
+Duration Solution::Route::releaseTime() const { return data_->release; }
 
-Cost Solution::Route::prizes() const { return prizes_; }
+Cost Solution::Route::prizes() const { return data_->prizes; }
 
 std::pair<double, double> const &Solution::Route::centroid() const
 {
-    return centroid_;
+    return data_->centroid;
 }
 
-size_t Solution::Route::vehicleType() const { return vehicleType_; }
+size_t Solution::Route::vehicleType() const { return data_->vehicleType; }
 
-size_t Solution::Route::depot() const { return depot_; }
+size_t Solution::Route::depot() const { return data_->depot; }
 
 bool Solution::Route::isFeasible() const
 {
     return !hasExcessLoad() && !hasTimeWarp();
 }
 
-bool Solution::Route::hasExcessLoad() const { return excessLoad_ > 0; }
+bool Solution::Route::hasExcessLoad() const { return data_->excessLoad > 0; }
 
-bool Solution::Route::hasTimeWarp() const { return timeWarp_ > 0; }
+bool Solution::Route::hasTimeWarp() const { return data_->timeWarp > 0; }
 
 bool Solution::Route::operator==(Solution::Route const &other) const
 {
-    // First compare simple attributes, since that's a quick and cheap check.
-    // Only when these are the same we test if the visits are all equal.
+    // Equal routes typically share their data, so we first check that.
+    if (data_ == other.data_)
+        return true;
+
+    // Routes that do not share data may still be equal when they only differ
+    // in attributes that are not compared here. We first compare simple
+    // attributes, since that's a quick and cheap check. Only when these are
+    // the same we test if the visits are all equal.
+    auto const &lhs = *data_;
+    auto const &rhs = *other.data_;
+
     // clang-format off
-    return distance_ == other.distance_
-        && delivery_ == other.delivery_
-        && pickup_ == other.pickup_
-        && timeWarp_ == other.timeWarp_
-        && vehicleType_ == other.vehicleType_
-        && visits_ == other.visits_;
+    return lhs.distance == rhs.distance
+        && lhs.delivery == rhs.delivery
+        && lhs.pickup == rhs.pickup
+        && lhs.timeWarp == rhs.timeWarp
+        && lhs.vehicleType == rhs.vehicleType
+        && lhs.visits == rhs.visits;
     // clang-format on
 }
 
@@ -5,9 +5,18 @@
 #include "ProblemData.h"
 #include "RandomNumberGenerator.h"
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <iosfwd>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace pyvrp
@@ -55,24 +64,14 @@ public:
     {
         using Visits = std::vector<Client>;
 
-        Visits visits_ = {};      // Client visits on this route
-        Distance distance_ = 0;   // Total travel distance on this route
-        Load delivery_ = 0;       // Total delivery amount served on this route
-        Load pickup_ = 0;         // Total pickup amount gathered on this route
-        Load excessLoad_ = 0;     // Excess pickup or delivery demand
-        Duration duration_ = 0;   // Total duration of this route
-        Duration timeWarp_ = 0;   // Total time warp on this route
-        Duration travel_ = 0;     // Total *travel* duration on this route
-        Duration service_ = 0;    // Total *service* duration on this route
-        Duration wait_ = 0;       // Total *waiting* duration on this route
-        Duration release_ = 0;    // Release time of this route
-        Duration startTime_ = 0;  // (earliest) start time of this route
-        Duration slack_ = 0;      // Total time slack on this route
-        Cost prizes_ = 0;         // Total value of prizes on this route
-
-        std::pair<double, double> centroid_;  // Route center
-        VehicleType vehicleType_;             // Type of vehicle
-        Depot depot_;                         // Assigned depot
+        // Route visits and statistics. These are immutable once constructed,
+        // and shared between copies of the same route. Copying a route thus
+        // only increments a reference count. Solutions in a subpopulation
+        // also share the data of equal routes; see Solution::shareRoutes().
+        struct Data;
+        std::shared_ptr<Data const> data_;
+
+        friend class Solution;
 
     public:
         [[nodiscard]] bool empty() const;
@@ -198,6 +197,39 @@ public:
 
         bool operator==(Route const &other) const;
 
+        /**
+         * Returns a compact binary representation of this route.
+         *
+         * Returns
+         * -------
+         * bytes
+         *     Binary representation of this route.
+         */
+        [[nodiscard]] std::string toBytes() const;
+
+        /**
+         * from_bytes(data: bytes) -> Route
+         *
+         * Reconstructs a route from its binary representation, as returned by
+         * :meth:`~to_bytes`.
+         *
+         * Parameters
+         * ----------
+         * data
+         *     Binary representation of a route.
+         *
+         * Returns
+         * -------
+         * Route
+         *     The reconstructed route.
+         *
+         * Raises
+         * ------
+         * ValueError
+         *     When the given data does not describe a route.
+         */
+        static Route fromBytes(std::string_view data);
+
         Route() = delete;
 
         Route(ProblemData const &data,
@@ -237,22 +269,86 @@ private:
     Cost prizes_ = 0;               // Total collected prize value
     Cost uncollectedPrizes_ = 0;    // Total uncollected prize value
     Duration timeWarp_ = 0;         // Total time warp over all routes
+    size_t hash_ = 0;               // Hash of the solution's structure
 
     Routes routes_;
-    Neighbours neighbours_;  // client [pred, succ] pairs, null if unassigned
 
-    // Determines the [pred, succ] pairs for assigned clients.
-    void makeNeighbours(ProblemData const &data);
+    // Packed predecessor and successor of each location, with UNASSIGNED for
+    // locations that are not in the solution. The first half of this buffer
+    // stores the predecessors, the second half the successors. This compact
+    // layout allows fast copies and comparisons between solutions.
+    std::vector<uint32_t> neighbours_;
+
+    // Sketch that is only computed when it is first requested. Only the
+    // approximate broken pairs distance uses it, and it may request the same
+    // solution's sketch from multiple threads at once, so computing it is
+    // guarded by a mutex.
+    class LazySketch
+    {
+        mutable std::vector<uint64_t> values_;
+        mutable std::atomic<bool> ready_ = false;
+        mutable std::mutex mutex_;
+
+    public:
+        LazySketch() = default;
+        LazySketch(LazySketch const &other);
+        LazySketch(LazySketch &&other);
+
+        LazySketch &operator=(LazySketch const &other);
+        LazySketch &operator=(LazySketch &&other);
+
+        // Returns the sketch of the given solution, computing it first if
+        // that has not yet happened.
+        std::vector<uint64_t> const &get(Solution const &solution) const;
+    };
+
+    // Bottom-k MinHash sketch of the solution's (pred, client) and (client,
+    // succ) pairs: the SKETCH_SIZE smallest hash values, in ascending order.
+    LazySketch sketch_;
+
+    // Route data of the solutions in a subpopulation, by hash. Equal routes of
+    // these solutions share their data through this table. It only refers to
+    // that data, and does not own it.
+    struct RouteTable
+    {
+        std::unordered_multimap<size_t, std::weak_ptr<Route::Data const>> data;
+        size_t sweepSize = 1024;  // size at which expired entries are removed
+    };
+
+    // Replaces the data of this solution's routes by equal data from the given
+    // table, and adds the data of routes that are not yet in the table.
+    void shareRoutes(RouteTable &table);
+
+    // Determines the packed [pred, succ] pairs for assigned clients, and the
+    // structural hash that derives from these.
+    void makeNeighbours();
+
+    // Determines the structural hash of this solution from its routes.
+    void makeHash();
+
+    // Determines the MinHash sketch of this solution from its routes, and
+    // stores it in the given vector.
+    void makeSketch(std::vector<uint64_t> &sketch) const;
 
     // Evaluates this solution's characteristics.
     void evaluate(ProblemData const &data);
 
     // These are only available within a solution; from the outside a solution
-    // is immutable.
+    // is immutable. The subpopulation uses copy assignment to recycle memory
+    // of solutions it has purged.
+    friend class SubPopulation;
+
     Solution &operator=(Solution const &other) = default;
     Solution &operator=(Solution &&other) = default;
 
 public:
+    // Sentinel value used in the packed predecessor and successor arrays for
+    // locations that are not in the solution.
+    static constexpr uint32_t UNASSIGNED = std::numeric_limits<uint32_t>::max();
+
+    // Number of hash values in each solution's MinHash sketch.
+    static constexpr size_t SKETCH_SIZE = 128;
+
     // Solution is empty when it has no routes and no clients.
     [[nodiscard]] bool empty() const;
 
@@ -308,7 +404,27 @@ public:
      *     predecessor and successors in this solutions's routes. ``None`` in
      *     case the client is not in the solution (or is a depot).
      */
-    [[nodiscard]] Neighbours const &getNeighbours() const;
+    [[nodiscard]] Neighbours getNeighbours() const;
+
+    // Packed predecessor of each location, or UNASSIGNED if the location is
+    // not in this solution (or is a depot).
+    [[nodiscard]] std::span<uint32_t const> predecessors() const;
+
+    // Packed successor of each location, or UNASSIGNED if the location is not
+    // in this solution (or is a depot).
+    [[nodiscard]] std::span<uint32_t const> successors() const;
+
+    // Hash of this solution's structure: the (pred, succ) pair of each client,
+    // and the vehicle type of the route visiting it. This hash does not
+    // depend on the order of the routes, so solutions that compare equal have
+    // the same hash.
+    [[nodiscard]] size_t hash() const;
+
+    // MinHash sketch of the (pred, client) and (client, succ) pairs in this
+    // solution. This contains the (at most) SKETCH_SIZE smallest hash values
+    // of these pairs, in ascending order. The sketch is computed when it is
+    // first requested.
+    [[nodiscard]] std::vector<uint64_t> const &sketch() const;
 
     /**
      * Whether this solution is feasible. This is a shorthand for checking
@@ -417,6 +533,39 @@ public:
 
     bool operator==(Solution const &other) const;
 
+    /**
+     * Returns a compact binary representation of this solution.
+     *
+     * Returns
+     * -------
+     * bytes
+     *     Binary representation of this solution.
+     */
+    [[nodiscard]] std::string toBytes() const;
+
+    /**
+     * from_bytes(data: bytes) -> Solution
+     *
+     * Reconstructs a solution from its binary representation, as returned by
+     * :meth:`~to_bytes`.
+     *
+     * Parameters
+     * ----------
+     * data
+     *     Binary representation of a solution.
+     *
+     * Returns
+     * -------
+     * Solution
+     *     The reconstructed solution.
+     *
+     * Raises
+     * ------
+     * ValueError
+     *     When the given data does not describe a solution.
+     */
+    static Solution fromBytes(std::string_view data);
+
     Solution(Solution const &other) = default;
     Solution(Solution &&other) = default;
 
@@ -467,7 +616,7 @@ public:
              Cost uncollectedPrizes,
              Duration timeWarp,
              Routes const &routes,
-             Neighbours neighbours);
+             size_t numLocations);
 };
 }  // namespace pyvrp
 
@@ -477,16 +626,7 @@ std::ostream &operator<<(std::ostream &out,
 
 template <> struct std::hash<pyvrp::Solution>
 {
-    size_t operator()(pyvrp::Solution const &sol) const
-    {
-        size_t res = 17;
-        res = res * 31 + std::hash<size_t>()(sol.numRoutes());
-        res = res * 31 + std::hash<pyvrp::Distance>()(sol.distance());
-        res = res * 31 + std::hash<pyvrp::Load>()(sol.excessLoad());
-        res = res * 31 + std::hash<pyvrp::Duration>()(sol.timeWarp());
-
-        return res;
-    }
+    size_t operator()(pyvrp::Solution const &sol) const { return sol.hash(); }
 };
 
 #endif  // PYVRP_SOLUTION_H
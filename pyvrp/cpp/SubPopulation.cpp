@@ -1,10 +1,29 @@
 #include "SubPopulation.h"
 
+#include <algorithm>
 #include <numeric>
+#include <thread>
 
 using pyvrp::SubPopulation;
+using pyvrp::ThreadPool;
 using const_iter = std::vector<SubPopulation::Item>::const_iterator;
 using iter = std::vector<SubPopulation::Item>::iterator;
+using Parents = std::pair<pyvrp::Solution const *, pyvrp::Solution const *>;
+
+namespace
+{
+// Diversity measures implemented in C++ are plain function pointers. These
+// can safely be evaluated from multiple threads.
+using NativeMeasure = double (*)(pyvrp::Solution const &,
+                                 pyvrp::Solution const &);
+
+// Orders cost ranking entries by cost, and then by insertion number.
+auto const byCostThenInsertion = [](auto const &first, auto const &second) {
+    return first.cost < second.cost
+           || (first.cost == second.cost
+               && first.insertion < second.insertion);
+};
+}  // namespace
 
 SubPopulation::SubPopulation(diversity::DiversityMeasure divOp,
                              PopulationParams const &params)
@@ -16,28 +35,82 @@ SubPopulation::~SubPopulation()
 {
     for (auto &item : items)
         delete item.solution;
+
+    for (auto *solution : solutionPool)
+        delete solution;
 }
 
 void SubPopulation::add(Solution const *solution,
                         CostEvaluator const &costEvaluator)
 {
-    // Copy the given solution into a new memory location, and use that from
-    // now on.
-    solution = new Solution(*solution);
-    Item item = {&params, solution, 0.0, {}};
+    // An equal solution is already in the subpopulation. Adding this one
+    // would only give a duplicate that survivor selection removes again, so
+    // we return before copying it or computing any distances.
+    if (hasDuplicate(*solution))
+        return;
 
-    for (auto &other : items)  // update distance to other solutions
+    // Copy the given solution into memory owned by this subpopulation, and
+    // use that from now on. If possible, we reuse a previously removed
+    // solution, since copy assignment can then reuse its buffers.
+    Solution *copy = nullptr;
+    if (solutionPool.empty())
+        copy = new Solution(*solution);
+    else
     {
-        auto const div = divOp(*solution, *other.solution);
-        auto cmp = [](auto &elem, auto &value) { return elem.first < value; };
+        copy = solutionPool.back();
+        solutionPool.pop_back();
+        *copy = *solution;
+    }
 
-        auto &oProx = other.proximity;
-        auto place = std::lower_bound(oProx.begin(), oProx.end(), div, cmp);
-        oProx.emplace(place, div, solution);
+    copy->shareRoutes(routeTable);
+    solution = copy;
 
-        auto &iProx = item.proximity;
-        place = std::lower_bound(iProx.begin(), iProx.end(), div, cmp);
-        iProx.emplace(place, div, other.solution);
+    auto const slot = acquireSlot();
+    slots[slot] = copy;
+
+    Item item = {this, solution, 0.0, slot, {}, true};
+
+    std::vector<double> divs(items.size());
+    computeDistances(*solution, divs);
+
+    slotsByHash.emplace(solution->hash(), slot);
+
+    if (rankingEvaluator)  // insert into the existing cost ranking
+    {
+        CostEntry const entry
+            = {rankingEvaluator->penalisedCost(*solution), numInserted, slot};
+        auto place = std::lower_bound(
+            byCost.begin(), byCost.end(), entry, byCostThenInsertion);
+        byCost.insert(place, entry);
+    }
+
+    numInserted++;
+    fitnessStale = true;
+
+    for (size_t idx = 0; idx != items.size(); ++idx)
+    {
+        auto &other = items[idx];
+        auto const div = divs[idx];
+        distances[slot * numSlots + other.slot] = div;
+        distances[other.slot * numSlots + slot] = div;
+
+        // The other item's closest list needs updating only when the new
+        // solution is among its nearest ones. Stale lists are recomputed on
+        // access anyway, so those we can leave alone.
+        if (other.stale)
+            continue;
+
+        auto &closest = other.closest;
+        if (closest.size() < params.nbClose || div < closest.back().first)
+        {
+            auto cmp = [](auto &elem, auto val) { return elem.first < val; };
+            auto place = std::lower_bound(
+                closest.begin(), closest.end(), div, cmp);
+            closest.emplace(place, div, slot);
+
+            if (closest.size() > params.nbClose)
+                closest.pop_back();
+        }
     }
 
     items.push_back(item);  // add solution
@@ -57,40 +130,151 @@ const_iter SubPopulation::cbegin() const { return items.cbegin(); }
 
 const_iter SubPopulation::cend() const { return items.cend(); }
 
-void SubPopulation::remove(iter const &iterator)
+bool SubPopulation::hasDuplicate(Solution const &solution) const
 {
-    for (auto &[params, solution, fitness, proximity] : items)
-        // Remove solution from other proximities.
-        for (size_t idx = 0; idx != proximity.size(); ++idx)
-            if (proximity[idx].second == iterator->solution)
-            {
-                proximity.erase(proximity.begin() + idx);
-                break;
-            }
-
-    delete iterator->solution;  // dispose of manually allocated memory
-    items.erase(iterator);      // before the item is removed.
+    auto const [begin, end] = slotsByHash.equal_range(solution.hash());
+    for (auto it = begin; it != end; ++it)
+        if (*slots[it->second] == solution)
+            return true;
+
+    return false;
 }
 
-void SubPopulation::purge(CostEvaluator const &costEvaluator)
+void SubPopulation::computeDistances(Solution const &solution,
+                                     std::vector<double> &divs) const
 {
-    // First we remove duplicates. This does not rely on the fitness values.
-    while (size() > params.minPopSize)
+    auto const compute = [&](auto const &measure, size_t begin, size_t end) {
+        for (auto idx = begin; idx != end; ++idx)
+            divs[idx] = measure(solution, *items[idx].solution);
+    };
+
+    auto const *native = divOp.target<NativeMeasure>();
+    auto const work = items.size() * solution.predecessors().size();
+    auto const numThreads = std::min<size_t>(
+        params.numThreads ? params.numThreads
+                          : std::thread::hardware_concurrency(),
+        items.size());
+
+    // Diversity measures implemented in Python need to hold the GIL, so we
+    // always evaluate those serially. The same goes for small workloads,
+    // where the overhead of coordinating threads outweighs the gains.
+    if (!native || work < params.parallelThreshold || numThreads <= 1)
     {
-        // Remove duplicates from the subpopulation (if they exist)
-        auto const pred = [&](auto &iterator) {
-            return !iterator.proximity.empty()
-                   && *iterator.proximity[0].second == *iterator.solution;
-        };
+        compute(divOp, 0, items.size());
+        return;
+    }
 
-        auto const duplicate = std::find_if(items.begin(), items.end(), pred);
+    // The calling thread also computes distances, so the pool needs one
+    // thread less than we use in total.
+    if (!pool || pool->numThreads() != numThreads - 1)
+        pool = std::make_unique<ThreadPool>(numThreads - 1);
 
-        if (duplicate == items.end())  // there are no more duplicates
-            break;
+    auto const chunkSize = (items.size() + numThreads - 1) / numThreads;
+    auto const numChunks = (items.size() + chunkSize - 1) / chunkSize;
+    pool->run(numChunks, [&](size_t chunk) {
+        auto const begin = chunk * chunkSize;
+        compute(*native, begin, std::min(begin + chunkSize, items.size()));
+    });
+}
+
+size_t SubPopulation::acquireSlot()
+{
+    if (freeSlots.empty())
+    {
+        // Grow the distance matrix, and copy over the existing distances
+        // into the new layout.
+        auto const newNumSlots
+            = std::max({2 * numSlots, params.maxPopSize() + 1, size_t(1)});
+
+        std::vector<double> newDistances(newNumSlots * newNumSlots, 0.0);
+        for (size_t row = 0; row != numSlots; ++row)
+            std::copy_n(distances.begin() + row * numSlots,
+                        numSlots,
+                        newDistances.begin() + row * newNumSlots);
+
+        distances = std::move(newDistances);
+        slots.resize(newNumSlots, nullptr);
+
+        for (auto slot = newNumSlots; slot != numSlots; --slot)
+            freeSlots.push_back(slot - 1);  // so lowest slots are used first
+
+        numSlots = newNumSlots;
+    }
+
+    auto const slot = freeSlots.back();
+    freeSlots.pop_back();
+    return slot;
+}
+
+void SubPopulation::updateClosest(Item const &item) const
+{
+    auto const nbClose = std::min(params.nbClose, size() - 1);
+    if (!item.stale && item.closest.size() == nbClose)
+        return;
+
+    candidates.clear();
+    for (auto const &other : items)
+        if (other.slot != item.slot)
+        {
+            auto const div = distances[item.slot * numSlots + other.slot];
+            candidates.emplace_back(div, other.slot);
+        }
+
+    // We only need the nbClose nearest solutions in sorted order, so we first
+    // partition around the nbClose-th element, and then sort only the part
+    // before it. The closest list has room for one more element, since add()
+    // inserts before dropping the furthest element.
+    auto const cmp = [](auto &a, auto &b) { return a.first < b.first; };
+    auto const nth = candidates.begin() + nbClose;
+    std::nth_element(candidates.begin(), nth, candidates.end(), cmp);
+
+    auto &closest = item.closest;
+    closest.reserve(params.nbClose + 1);
+    closest.assign(candidates.begin(), nth);
+    std::sort(closest.begin(), closest.end(), cmp);
+
+    item.stale = false;
+}
 
-        remove(duplicate);
+void SubPopulation::remove(iter const &iterator)
+{
+    auto const slot = iterator->slot;
+
+    for (auto &other : items)
+    {
+        // Closest lists that contain the removed solution are now stale.
+        auto const &closest = other.closest;
+        auto const pred = [&](auto const &elem) { return elem.second == slot; };
+        if (std::any_of(closest.begin(), closest.end(), pred))
+            other.stale = true;
     }
 
+    auto const hash = iterator->solution->hash();
+    auto const [begin, end] = slotsByHash.equal_range(hash);
+    for (auto it = begin; it != end; ++it)
+        if (it->second == slot)
+        {
+            slotsByHash.erase(it);
+            break;
+        }
+
+    auto const pred = [&](auto const &entry) { return entry.slot == slot; };
+    if (auto const it = std::find_if(byCost.begin(), byCost.end(), pred);
+        it != byCost.end())
+        byCost.erase(it);
+
+    fitnessStale = true;
+
+    solutionPool.push_back(slots[slot]);  // keep memory around for reuse
+    slots[slot] = nullptr;
+    freeSlots.push_back(slot);
+
+    items.erase(iterator);
+}
+
+void SubPopulation::purge(CostEvaluator const &costEvaluator)
+{
+    // Duplicate solutions are never added, so we purge by fitness only.
     while (size() > params.minPopSize)
     {
         // Before using fitness, we must update fitness
@@ -109,18 +293,42 @@ void SubPopulation::updateFitness(CostEvaluator const &costEvaluator)
     if (items.empty())
         return;
 
-    std::vector<size_t> byCost(size());
-    std::iota(byCost.begin(), byCost.end(), 0);
+    if (!rankingEvaluator || !(*rankingEvaluator == costEvaluator))
+    {
+        // The penalty values changed, so we need to recompute the costs and
+        // the ranking based on these costs.
+        // Items are stored in order of insertion, so their index serves as
+        // the insertion number of the ranking entries.
+        byCost.clear();
+        for (size_t idx = 0; idx != size(); ++idx)
+        {
+            auto const &item = items[idx];
+            auto const cost = costEvaluator.penalisedCost(*item.solution);
+            byCost.push_back({cost, idx, item.slot});
+        }
+
+        std::sort(byCost.begin(), byCost.end(), byCostThenInsertion);
+        numInserted = size();
+
+        rankingEvaluator = costEvaluator;
+        fitnessStale = true;
+    }
 
-    std::stable_sort(byCost.begin(), byCost.end(), [&](size_t a, size_t b) {
-        return costEvaluator.penalisedCost(*items[a].solution)
-               < costEvaluator.penalisedCost(*items[b].solution);
-    });
+    if (!fitnessStale && fitnessNbElite == params.nbElite
+        && fitnessNbClose == params.nbClose)
+        return;
+
+    std::vector<size_t> slotToIdx(numSlots);
+    for (size_t idx = 0; idx != size(); ++idx)
+        slotToIdx[items[idx].slot] = idx;
 
     std::vector<std::pair<double, size_t>> diversity;
+    diversity.reserve(size());
+
     for (size_t costRank = 0; costRank != size(); costRank++)
     {
-        auto const dist = items[byCost[costRank]].avgDistanceClosest();
+        auto const &item = items[slotToIdx[byCost[costRank].slot]];
+        auto const dist = item.avgDistanceClosest();
         diversity.emplace_back(-dist, costRank);  // higher is better
     }
 
@@ -133,18 +341,69 @@ void SubPopulation::updateFitness(CostEvaluator const &costEvaluator)
     for (size_t divRank = 0; divRank != size(); divRank++)
     {
         auto const costRank = diversity[divRank].second;
-        auto const idx = byCost[costRank];
+        auto const idx = slotToIdx[byCost[costRank].slot];
         items[idx].fitness = (costRank + divWeight * divRank) / (2 * popSize);
     }
+
+    fitnessStale = false;
+    fitnessNbElite = params.nbElite;
+    fitnessNbClose = params.nbClose;
 }
 
 double SubPopulation::Item::avgDistanceClosest() const
 {
-    auto const maxSize = std::min(proximity.size(), params->nbClose);
+    subPop->updateClosest(*this);
+
     auto result = 0.0;
+    for (auto const &[dist, slot] : closest)
+        result += dist;
+
+    return result / std::max<size_t>(closest.size(), 1);
+}
+
+Parents pyvrp::selectParents(SubPopulation const &feasible,
+                             SubPopulation const &infeasible,
+                             RandomNumberGenerator &rng,
+                             size_t k)
+{
+    if (k == 0)
+        throw std::invalid_argument("Expected k > 0.");
+
+    auto const numFeas = feasible.size();
+    auto const popSize = numFeas + infeasible.size();
+
+    if (popSize == 0)
+        throw std::runtime_error("Cannot select from an empty population.");
 
-    for (size_t idx = 0; idx != maxSize; ++idx)
-        result += proximity[idx].first;
+    auto const tournament = [&]() {
+        SubPopulation::Item const *fittest = nullptr;
+        for (size_t count = 0; count != k; ++count)
+        {
+            auto const idx = rng.randint(popSize);
+            auto const &item
+                = idx < numFeas ? feasible[idx] : infeasible[idx - numFeas];
+
+            if (!fittest || item.fitness < fittest->fitness)
+                fittest = &item;
+        }
+
+        return fittest->solution;
+    };
+
+    auto const *first = tournament();
+    auto const *second = tournament();
+
+    auto const &params = feasible.params;
+    auto diversity = feasible.divOp(*first, *second);
+
+    for (size_t tries = 1; tries <= 10; ++tries)
+    {
+        if (params.lbDiversity <= diversity && diversity <= params.ubDiversity)
+            break;
+
+        second = tournament();
+        diversity = feasible.divOp(*first, *second);
+    }
 
-    return result / std::max<size_t>(maxSize, 1);
+    return {first, second};
 }
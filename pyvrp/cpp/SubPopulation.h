@@ -2,12 +2,17 @@
 #define PYVRP_SUBPOPULATION_H
 
 #include "CostEvaluator.h"
+#include "RandomNumberGenerator.h"
 #include "Solution.h"
+#include "ThreadPool.h"
 #include "diversity/diversity.h"
 
 #include <functional>
 #include <iosfwd>
+#include <memory>
+#include <optional>
 #include <stdexcept>
+#include <unordered_map>
 #include <vector>
 
 namespace pyvrp
@@ -20,10 +25,16 @@ namespace pyvrp
  *     nb_close: int = 5,
  *     lb_diversity: float = 0.1,
  *     ub_diversity: float = 0.5,
+ *     num_threads: int = 0,
+ *     parallel_threshold: int = 500_000,
  * )
  *
  * Creates a parameters object to be used with
- * :class:`~pyvrp.Population.Population`.
+ * :class:`~pyvrp.Population.Population`. Distances between a new solution and
+ * the solutions in a subpopulation are computed on ``num_threads`` threads
+ * (or as many as the hardware supports, if zero), when the number of
+ * solutions times the number of locations is at least ``parallel_threshold``.
+ * This only applies to diversity measures implemented in C++.
  */
 struct PopulationParams
 {
@@ -33,19 +44,25 @@ struct PopulationParams
     size_t nbClose;
     double lbDiversity;
     double ubDiversity;
+    size_t numThreads;
+    size_t parallelThreshold;
 
     PopulationParams(size_t minPopSize = 25,
                      size_t generationSize = 40,
                      size_t nbElite = 4,
                      size_t nbClose = 5,
                      double lbDiversity = 0.1,
-                     double ubDiversity = 0.5)
+                     double ubDiversity = 0.5,
+                     size_t numThreads = 0,
+                     size_t parallelThreshold = 500'000)
         : minPopSize(minPopSize),
           generationSize(generationSize),
           nbElite(nbElite),
           nbClose(nbClose),
           lbDiversity(lbDiversity),
-          ubDiversity(ubDiversity)
+          ubDiversity(ubDiversity),
+          numThreads(numThreads),
+          parallelThreshold(parallelThreshold)
     {
         if (lbDiversity < 0 || lbDiversity > 1)
             throw std::invalid_argument("lb_diversity must be in [0, 1].");
@@ -72,8 +89,9 @@ struct PopulationParams
  * survivor selection (purging) when their number grows large. A
  * subpopulation's solutions can be accessed via indexing and iteration.
  * Each solution is stored as a tuple of type ``_Item``, which stores
- * the solution itself, a fitness score (higher is worse), and a list
- * of proximity values to the other solutions in the subpopulation.
+ * the solution itself, and a fitness score (higher is worse). Pairwise
+ * distances between the solutions in the subpopulation are tracked in a
+ * symmetric distance matrix.
  *
  * Parameters
  * ----------
@@ -82,17 +100,65 @@ struct PopulationParams
  * params
  *     Population parameters.
  */
+class SubPopulation;
+
+/**
+ * select_parents(
+ *     feasible: SubPopulation,
+ *     infeasible: SubPopulation,
+ *     rng: RandomNumberGenerator,
+ *     k: int = 2,
+ * ) -> tuple[Solution, Solution]
+ *
+ * Selects two (if possible non-identical) parents by k-ary tournament from the
+ * solutions in the given subpopulations, subject to a diversity restriction.
+ * The fitness values of both subpopulations must be up-to-date.
+ *
+ * Parameters
+ * ----------
+ * feasible
+ *     Subpopulation of feasible solutions.
+ * infeasible
+ *     Subpopulation of infeasible solutions.
+ * rng
+ *     Random number generator.
+ * k
+ *     The number of solutions to draw for each tournament. Defaults to two,
+ *     which results in a binary tournament.
+ *
+ * Returns
+ * -------
+ * tuple
+ *     A solution pair (parents).
+ *
+ * Raises
+ * ------
+ * ValueError
+ *     When k is zero.
+ */
+std::pair<Solution const *, Solution const *>
+selectParents(SubPopulation const &feasible,
+              SubPopulation const &infeasible,
+              RandomNumberGenerator &rng,
+              size_t k = 2);
+
 class SubPopulation
 {
+    friend std::pair<Solution const *, Solution const *>
+    selectParents(SubPopulation const &feasible,
+                  SubPopulation const &infeasible,
+                  RandomNumberGenerator &rng,
+                  size_t k);
+
     diversity::DiversityMeasure divOp;
     PopulationParams const &params;  // owned by Population, on the Python side
 
 public:
     struct Item
     {
-        using Proximity = std::vector<std::pair<double, Solution const *>>;
+        using Proximity = std::vector<std::pair<double, size_t>>;
 
-        PopulationParams const *params;
+        SubPopulation const *subPop;
 
         // Note that this pointer is not owned by the Item - it is merely a
         // reference to memory owned and allocated by the SubPopulation this
@@ -103,7 +169,16 @@ public:
         // Fitness should be used carefully: only directly after updateFitness
         // was called. At any other moment, it will be outdated.
         double fitness;
-        Proximity proximity;
+
+        // Row and column of this item's solution in the distance matrix.
+        size_t slot;
+
+        // Distances to (and slots of) the nearest other solutions, in
+        // ascending order of distance. This is computed lazily from the
+        // distance matrix: when the list is stale, it is recomputed upon
+        // first access.
+        mutable Proximity closest;
+        mutable bool stale;
 
         double avgDistanceClosest() const;
     };
@@ -111,6 +186,72 @@ public:
 private:
     std::vector<Item> items;
 
+    // Pairwise distances between solutions, indexed by slot. The matrix is
+    // stored as a flat, row-major vector with numSlots rows and columns.
+    // Slots are reused once their solution is removed.
+    std::vector<double> distances;
+    std::vector<Solution *> slots;  // nullptr if the slot is unused
+    std::vector<size_t> freeSlots;
+    size_t numSlots = 0;
+
+    // Route data of the solutions in the subpopulation. Equal routes of these
+    // solutions share their data.
+    Solution::RouteTable routeTable;
+
+    // Solutions that were removed from the subpopulation. Their memory is
+    // reused for solutions that are added later, which avoids reallocating
+    // route and neighbour buffers.
+    std::vector<Solution *> solutionPool;
+
+    // Penalised cost ranking of the solutions in the subpopulation, as
+    // (cost, insertion number, slot) entries. The insertion number breaks
+    // ties in favour of solutions that were added earlier. The costs are
+    // computed using rankingEvaluator, and the ranking is kept up-to-date as
+    // solutions are added or removed.
+    struct CostEntry
+    {
+        Cost cost;
+        size_t insertion;
+        size_t slot;
+    };
+
+    std::vector<CostEntry> byCost;
+    std::optional<CostEvaluator> rankingEvaluator;
+    size_t numInserted = 0;
+
+    // Whether the fitness values need to be recomputed. That is the case when
+    // solutions were added or removed since the last fitness update, or when
+    // the relevant parameters changed.
+    bool fitnessStale = true;
+    size_t fitnessNbElite = 0;
+    size_t fitnessNbClose = 0;
+
+    // Slots of the solutions in the subpopulation, by solution hash. This
+    // allows finding duplicate solutions without comparing all pairs.
+    std::unordered_multimap<size_t, size_t> slotsByHash;
+
+    // Returns whether the subpopulation contains a solution that is equal to
+    // the given solution.
+    bool hasDuplicate(Solution const &solution) const;
+
+    // Worker threads used to compute distances in parallel. These are started
+    // the first time they are needed.
+    mutable std::unique_ptr<ThreadPool> pool;
+
+    // Computes the distances between the given solution and all solutions in
+    // the subpopulation, and stores them in the given vector.
+    void computeDistances(Solution const &solution,
+                          std::vector<double> &divs) const;
+
+    // Returns an unused slot, growing the distance matrix if needed.
+    size_t acquireSlot();
+
+    // Scratch space used when determining an item's closest list.
+    mutable Item::Proximity candidates;
+
+    // Ensures the given item's closest list is up-to-date.
+    void updateClosest(Item const &item) const;
+
     // Removes the element at the given iterator location from the items.
     void remove(std::vector<Item>::iterator const &iterator);
 
@@ -123,6 +264,8 @@ public:
     /**
      * Adds the given solution to the subpopulation. Survivor selection is
      * automatically triggered when the population reaches its maximum size.
+     * The solution is not added when the subpopulation already contains an
+     * equal solution.
      *
      * Parameters
      * ----------
@@ -144,8 +287,8 @@ public:
     /**
      * Performs survivor selection: solutions in the subpopulation are
      * purged until the population is reduced to the ``min_pop_size``.
-     * Purging happens to duplicate solutions first, and then to solutions
-     * with high biased fitness.
+     * Solutions with high biased fitness are purged first. The subpopulation
+     * contains no duplicate solutions, since those are never added.
      *
      * Parameters
      * ----------
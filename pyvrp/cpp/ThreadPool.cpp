@@ -0,0 +1,53 @@
+#include "ThreadPool.h"
+
+using pyvrp::ThreadPool;
+
+ThreadPool::ThreadPool(size_t numThreads)
+{
+    workers_.reserve(numThreads);
+    for (size_t idx = 0; idx != numThreads; ++idx)
+        workers_.emplace_back([this](std::stop_token token) { work(token); });
+}
+
+size_t ThreadPool::numThreads() const { return workers_.size(); }
+
+void ThreadPool::runTasks(std::unique_lock<std::mutex> &lock)
+{
+    while (next_ < numTasks_)
+    {
+        auto const idx = next_++;
+
+        lock.unlock();
+        (*task_)(idx);
+        lock.lock();
+
+        if (++numDone_ == numTasks_)
+            done_.notify_all();
+    }
+}
+
+void ThreadPool::work(std::stop_token token)
+{
+    std::unique_lock lock(mutex_);
+    while (wake_.wait(lock, token, [&] { return next_ < numTasks_; }))
+        runTasks(lock);
+}
+
+void ThreadPool::run(size_t numTasks, std::function<void(size_t)> const &task)
+{
+    std::unique_lock lock(mutex_);
+    task_ = &task;
+    numTasks_ = numTasks;
+    next_ = 0;
+    numDone_ = 0;
+
+    wake_.notify_all();
+    runTasks(lock);
+    done_.wait(lock, [&] { return numDone_ == numTasks_; });
+
+    // Clear the batch, so that workers that wake up late do not pick up any
+    // of its tasks.
+    task_ = nullptr;
+    numTasks_ = 0;
+    next_ = 0;
+}
@@ -0,0 +1,67 @@
+#ifndef PYVRP_THREADPOOL_H
+#define PYVRP_THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pyvrp
+{
+/**
+ * Fixed set of worker threads that repeatedly run batches of tasks. The
+ * threads are started once, and wait for work in between batches, so that
+ * running a batch does not pay for starting and joining threads.
+ */
+class ThreadPool
+{
+    std::mutex mutex_;
+    std::condition_variable_any wake_;  // signalled when a batch starts
+    std::condition_variable done_;      // signalled when a batch completes
+
+    std::function<void(size_t)> const *task_ = nullptr;
+    size_t numTasks_ = 0;  // number of tasks in the current batch
+    size_t next_ = 0;      // next task to hand out
+    size_t numDone_ = 0;   // number of completed tasks
+
+    // Declared last, so that the threads are stopped and joined before the
+    // members above are destroyed.
+    std::vector<std::jthread> workers_;
+
+    // Runs tasks of the current batch until none are left. Expects the lock
+    // to be held.
+    void runTasks(std::unique_lock<std::mutex> &lock);
+
+    void work(std::stop_token token);
+
+public:
+    /**
+     * Starts a pool of the given number of threads. Batches are also run on
+     * the calling thread, so a pool with zero threads runs them serially.
+     *
+     * @param numThreads Number of worker threads.
+     */
+    explicit ThreadPool(size_t numThreads);
+
+    ThreadPool(ThreadPool const &other) = delete;
+    ThreadPool &operator=(ThreadPool const &other) = delete;
+
+    /**
+     * @return Number of worker threads.
+     */
+    [[nodiscard]] size_t numThreads() const;
+
+    /**
+     * Calls task(idx) for each idx in [0, numTasks), on the worker threads
+     * and the calling thread, and returns once all calls have completed. The
+     * task must not throw.
+     *
+     * @param numTasks Number of tasks to run.
+     * @param task     Function to call for each task.
+     */
+    void run(size_t numTasks, std::function<void(size_t)> const &task);
+};
+}  // namespace pyvrp
+
+#endif  // PYVRP_THREADPOOL_H
@@ -5,11 +5,14 @@
 #include "DynamicBitset.h"
 #include "LoadSegment.h"
 #include "Matrix.h"
+#include "Metric.h"
 #include "ProblemData.h"
 #include "RandomNumberGenerator.h"
 #include "Solution.h"
 #include "SubPopulation.h"
+#include "instance_file.h"
 #include "pyvrp_docs.h"
+#include "read_instance.h"
 
 #include <pybind11/functional.h>
 #include <pybind11/numpy.h>
@@ -27,12 +30,36 @@ using pyvrp::DurationSegment;
 using pyvrp::DynamicBitset;
 using pyvrp::LoadSegment;
 using pyvrp::Matrix;
+using pyvrp::Metric;
 using pyvrp::PopulationParams;
 using pyvrp::ProblemData;
 using pyvrp::RandomNumberGenerator;
 using pyvrp::Solution;
 using pyvrp::SubPopulation;
 
+namespace
+{
+// Reconstructs an object of type T from the binary data in the given buffer,
+// which may be any object supporting the buffer protocol, such as bytes. The
+// buffer must be C-contiguous, since its data is read as a single block.
+template <typename T> T fromBuffer(py::buffer const &buffer)
+{
+    auto const info = buffer.request();
+
+    auto expected = info.itemsize;
+    for (auto dim = info.ndim; dim-- > 0;)
+    {
+        if (info.shape[dim] > 1 && info.strides[dim] != expected)
+            throw py::value_error("Expected a C-contiguous buffer.");
+
+        expected *= info.shape[dim];
+    }
+
+    auto const size = static_cast<size_t>(info.size * info.itemsize);
+    return T::fromBytes({static_cast<char const *>(info.ptr), size});
+}
+}  // namespace
+
 PYBIND11_MODULE(_pyvrp, m)
 {
     py::class_<DynamicBitset>(m, "DynamicBitset", DOC(pyvrp, DynamicBitset))
@@ -157,6 +184,18 @@ PYBIND11_MODULE(_pyvrp, m)
             },
             py::return_value_policy::reference_internal);
 
+    py::class_<Metric>(m, "Metric", DOC(pyvrp, Metric))
+        .def(py::init<std::string const &, double, double>(),
+             py::arg("kind") = "euclidean",
+             py::arg("scale") = 1.0,
+             py::arg("degrees_per_unit") = 1.0)
+        .def_property_readonly("kind", &Metric::kind, DOC(pyvrp, Metric, kind))
+        .def_property_readonly(
+            "scale", &Metric::scale, DOC(pyvrp, Metric, scale))
+        .def_property_readonly("degrees_per_unit",
+                               &Metric::degreesPerUnit,
+                               DOC(pyvrp, Metric, degreesPerUnit));
+
     py::class_<ProblemData>(m, "ProblemData", DOC(pyvrp, ProblemData))
         .def(py::init<std::vector<ProblemData::Client> const &,
                       std::vector<ProblemData::Depot> const &,
@@ -191,6 +230,18 @@ PYBIND11_MODULE(_pyvrp, m)
         .def_property_readonly("num_vehicles",
                                &ProblemData::numVehicles,
                                DOC(pyvrp, ProblemData, numVehicles))
+        .def_property_readonly("has_time_windows",
+                               &ProblemData::hasTimeWindows,
+                               DOC(pyvrp, ProblemData, hasTimeWindows))
+        .def_property_readonly("has_pickups",
+                               &ProblemData::hasPickups,
+                               DOC(pyvrp, ProblemData, hasPickups))
+        .def_property_readonly("has_release_times",
+                               &ProblemData::hasReleaseTimes,
+                               DOC(pyvrp, ProblemData, hasReleaseTimes))
+        .def_property_readonly("has_optional_clients",
+                               &ProblemData::hasOptionalClients,
+                               DOC(pyvrp, ProblemData, hasOptionalClients))
         .def(
             "location",
             [](ProblemData const &data, size_t idx) {
@@ -244,7 +295,22 @@ PYBIND11_MODULE(_pyvrp, m)
              &ProblemData::duration,
              py::arg("first"),
              py::arg("second"),
-             DOC(pyvrp, ProblemData, duration));
+             DOC(pyvrp, ProblemData, duration))
+        .def(
+            "to_bytes",
+            [](ProblemData const &data) { return py::bytes(data.toBytes()); },
+            DOC(pyvrp, ProblemData, toBytes))
+        .def_static("from_bytes",
+                    &fromBuffer<ProblemData>,
+                    py::arg("data"),
+                    DOC(pyvrp, ProblemData, fromBytes))
+        .def(py::pickle(
+            [](ProblemData const &data) {  // __getstate__
+                return py::bytes(data.toBytes());
+            },
+            [](py::buffer const &state) {  // __setstate__
+                return fromBuffer<ProblemData>(state);
+            }));
 
     py::class_<Solution::Route>(m, "Route", DOC(pyvrp, Solution, Route))
         .def(py::init<ProblemData const &, std::vector<size_t>, size_t>(),
@@ -327,48 +393,22 @@ PYBIND11_MODULE(_pyvrp, m)
             },
             py::arg("idx"))
         .def(py::self == py::self)  // this is __eq__
+        .def(
+            "to_bytes",
+            [](Solution::Route const &route) {
+                return py::bytes(route.toBytes());
+            },
+            DOC(pyvrp, Solution, Route, toBytes))
+        .def_static("from_bytes",
+                    &fromBuffer<Solution::Route>,
+                    py::arg("data"),
+                    DOC(pyvrp, Solution, Route, fromBytes))
         .def(py::pickle(
             [](Solution::Route const &route) {  // __getstate__
-                // Returns a tuple that completely encodes the route's state.
-                return py::make_tuple(route.visits(),
-                                      route.distance(),
-                                      route.delivery(),
-                                      route.pickup(),
-                                      route.excessLoad(),
-                                      route.duration(),
-                                      route.timeWarp(),
-                                      route.travelDuration(),
-                                      route.serviceDuration(),
-                                      route.waitDuration(),
-                                      route.releaseTime(),
-                                      route.startTime(),
-                                      route.slack(),
-                                      route.prizes(),
-                                      route.centroid(),
-                                      route.vehicleType(),
-                                      route.depot());
+                return py::bytes(route.toBytes());
             },
-            [](py::tuple t) {  // __setstate__
-                Solution::Route route = Solution::Route(
-                    t[0].cast<std::vector<size_t>>(),         // visits
-                    t[1].cast<pyvrp::Distance>(),             // distance
-                    t[2].cast<pyvrp::Load>(),                 // delivery
-                    t[3].cast<pyvrp::Load>(),                 // pickup
-                    t[4].cast<pyvrp::Load>(),                 // excess load
-                    t[5].cast<pyvrp::Duration>(),             // duration
-                    t[6].cast<pyvrp::Duration>(),             // time warp
-                    t[7].cast<pyvrp::Duration>(),             // travel
-                    t[8].cast<pyvrp::Duration>(),             // service
-                    t[9].cast<pyvrp::Duration>(),             // wait
-                    t[10].cast<pyvrp::Duration>(),            // release
-                    t[11].cast<pyvrp::Duration>(),            // start time
-                    t[12].cast<pyvrp::Duration>(),            // slack
-                    t[13].cast<pyvrp::Cost>(),                // prizes
-                    t[14].cast<std::pair<double, double>>(),  // centroid
-                    t[15].cast<size_t>(),                     // vehicle type
-                    t[16].cast<size_t>());                    // depot
-
-                return route;
+            [](py::buffer const &state) {  // __setstate__
+                return fromBuffer<Solution::Route>(state);
             }))
         .def("__str__", [](Solution::Route const &route) {
             std::stringstream stream;
@@ -420,7 +460,6 @@ PYBIND11_MODULE(_pyvrp, m)
              DOC(pyvrp, Solution, getRoutes))
         .def("get_neighbours",
              &Solution::getNeighbours,
-             py::return_value_policy::reference_internal,
              DOC(pyvrp, Solution, getNeighbours))
         .def("is_feasible",
              &Solution::isFeasible,
@@ -454,38 +493,20 @@ PYBIND11_MODULE(_pyvrp, m)
         .def("__hash__",
              [](Solution const &sol) { return std::hash<Solution>()(sol); })
         .def(py::self == py::self)  // this is __eq__
+        .def(
+            "to_bytes",
+            [](Solution const &sol) { return py::bytes(sol.toBytes()); },
+            DOC(pyvrp, Solution, toBytes))
+        .def_static("from_bytes",
+                    &fromBuffer<Solution>,
+                    py::arg("data"),
+                    DOC(pyvrp, Solution, fromBytes))
         .def(py::pickle(
             [](Solution const &sol) {  // __getstate__
-                // Returns a tuple that completely encodes the solution's state.
-                return py::make_tuple(sol.numClients(),
-                                      sol.numMissingClients(),
-                                      sol.distance(),
-                                      sol.excessLoad(),
-                                      sol.fixedVehicleCost(),
-                                      sol.prizes(),
-                                      sol.uncollectedPrizes(),
-                                      sol.timeWarp(),
-                                      sol.getRoutes(),
-                                      sol.getNeighbours());
+                return py::bytes(sol.toBytes());
             },
-            [](py::tuple t) {  // __setstate__
-                using Routes = std::vector<Solution::Route>;
-                using Neighbours
-                    = std::vector<std::optional<std::pair<size_t, size_t>>>;
-
-                Solution sol
-                    = Solution(t[0].cast<size_t>(),           // num clients
-                               t[1].cast<size_t>(),           // num missing
-                               t[2].cast<pyvrp::Distance>(),  // distance
-                               t[3].cast<pyvrp::Load>(),      // excess load
-                               t[4].cast<pyvrp::Cost>(),      // fixed veh cost
-                               t[5].cast<pyvrp::Cost>(),      // prizes
-                               t[6].cast<pyvrp::Cost>(),      // uncollected
-                               t[7].cast<pyvrp::Duration>(),  // time warp
-                               t[8].cast<Routes>(),           // routes
-                               t[9].cast<Neighbours>());      // neighbours
-
-                return sol;
+            [](py::buffer const &state) {  // __setstate__
+                return fromBuffer<Solution>(state);
             }))
         .def("__str__", [](Solution const &sol) {
             std::stringstream stream;
@@ -520,20 +541,32 @@ PYBIND11_MODULE(_pyvrp, m)
 
     py::class_<PopulationParams>(
         m, "PopulationParams", DOC(pyvrp, PopulationParams))
-        .def(py::init<size_t, size_t, size_t, size_t, double, double>(),
+        .def(py::init<size_t,
+                      size_t,
+                      size_t,
+                      size_t,
+                      double,
+                      double,
+                      size_t,
+                      size_t>(),
              py::arg("min_pop_size") = 25,
              py::arg("generation_size") = 40,
              py::arg("nb_elite") = 4,
              py::arg("nb_close") = 5,
              py::arg("lb_diversity") = 0.1,
-             py::arg("ub_diversity") = 0.5)
+             py::arg("ub_diversity") = 0.5,
+             py::arg("num_threads") = 0,
+             py::arg("parallel_threshold") = 500'000)
         .def_readwrite("min_pop_size", &PopulationParams::minPopSize)
         .def_readwrite("generation_size", &PopulationParams::generationSize)
         .def_property_readonly("max_pop_size", &PopulationParams::maxPopSize)
         .def_readwrite("nb_elite", &PopulationParams::nbElite)
         .def_readwrite("nb_close", &PopulationParams::nbClose)
         .def_readwrite("lb_diversity", &PopulationParams::lbDiversity)
-        .def_readwrite("ub_diversity", &PopulationParams::ubDiversity);
+        .def_readwrite("ub_diversity", &PopulationParams::ubDiversity)
+        .def_readwrite("num_threads", &PopulationParams::numThreads)
+        .def_readwrite("parallel_threshold",
+                       &PopulationParams::parallelThreshold);
 
     py::class_<SubPopulation::Item>(m, "SubPopulationItem")
         .def_readonly("solution",
@@ -616,6 +649,95 @@ PYBIND11_MODULE(_pyvrp, m)
              py::arg("cost_evaluator"),
              DOC(pyvrp, SubPopulation, updateFitness));
 
+    // The diversity measure might be implemented in Python, but pybind11
+    // re-acquires the GIL whenever such a measure is called. The parents are
+    // returned as copies, since either subpopulation may reuse the memory of
+    // its solutions once they are purged or the population is cleared.
+    // Copies are cheap, because solutions share their route data.
+    m.def(
+        "select_parents",
+        [](SubPopulation const &feasible,
+           SubPopulation const &infeasible,
+           RandomNumberGenerator &rng,
+           size_t k) {
+            auto const [first, second]
+                = pyvrp::selectParents(feasible, infeasible, rng, k);
+            return std::make_pair(*first, *second);
+        },
+        py::arg("feasible"),
+        py::arg("infeasible"),
+        py::arg("rng"),
+        py::arg("k") = 2,
+        py::call_guard<py::gil_scoped_release>(),
+        DOC(pyvrp, selectParents));
+
+    // The matrix is written directly from the array's buffer, since matrices
+    // that warrant a file are typically too large to comfortably copy.
+    using ValueArray = py::array_t<pyvrp::Value,
+                                   py::array::c_style | py::array::forcecast>;
+
+    m.def(
+        "write_matrix",
+        [](py::object const &path, ValueArray const &matrix) {
+            if (matrix.ndim() != 2)
+                throw py::value_error("Expected 2D np.ndarray argument!");
+
+            auto const os = py::module_::import("os");
+            auto const fsPath = os.attr("fspath")(path).cast<std::string>();
+            pyvrp::writeMatrixFile(
+                fsPath, matrix.data(), matrix.shape(0), matrix.shape(1));
+        },
+        py::arg("path"),
+        py::arg("matrix"),
+        DOC(pyvrp, writeMatrixFile));
+
+    py::register_exception<pyvrp::UnsupportedInstanceError>(
+        m, "UnsupportedInstanceError", PyExc_ValueError);
+
+    m.def(
+        "read_instance",
+        [](py::object const &path,
+           std::string const &instanceFormat,
+           std::string const &roundFunc) {
+            auto const os = py::module_::import("os");
+            auto const fsPath = os.attr("fspath")(path).cast<std::string>();
+
+            py::gil_scoped_release release;
+            return pyvrp::readInstance(fsPath, instanceFormat, roundFunc);
+        },
+        py::arg("path"),
+        py::arg("instance_format") = "vrplib",
+        py::arg("round_func") = "none",
+        DOC(pyvrp, readInstance));
+
+    m.def(
+        "write_instance_file",
+        [](py::object const &path,
+           ProblemData const &data,
+           std::optional<pyvrp::Neighbours> const &neighbours) {
+            auto const os = py::module_::import("os");
+            auto const fsPath = os.attr("fspath")(path).cast<std::string>();
+
+            py::gil_scoped_release release;
+            pyvrp::writeInstanceFile(fsPath, data, neighbours);
+        },
+        py::arg("path"),
+        py::arg("data"),
+        py::arg("neighbours") = py::none(),
+        DOC(pyvrp, writeInstanceFile));
+
+    m.def(
+        "read_instance_file",
+        [](py::object const &path) {
+            auto const os = py::module_::import("os");
+            auto const fsPath = os.attr("fspath")(path).cast<std::string>();
+
+            py::gil_scoped_release release;
+            return pyvrp::readInstanceFile(fsPath);
+        },
+        py::arg("path"),
+        DOC(pyvrp, readInstanceFile));
+
     py::class_<DistanceSegment>(
         m, "DistanceSegment", DOC(pyvrp, DistanceSegment))
         .def(py::init<size_t, size_t, pyvrp::Distance>(),
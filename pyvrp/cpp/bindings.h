@@ -1,16 +1,21 @@
 #include "Matrix.h"
 #include "Measure.h"
+#include "Metric.h"
 
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 
+#include <memory>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 namespace pybind11::detail
 {
 // This is not a fully general type caster for Matrix. Instead, it assumes
 // we're casting elements that are, or have the same size as, pyvrp::Value,
-// which is the case for e.g. the Measure types.
+// which is the case for e.g. the Measure types. Such matrices may store their
+// elements in a narrower integer type; see Matrix::compact().
 template <typename T> struct type_caster<pyvrp::Matrix<T>>
 {
     static_assert(sizeof(T) == sizeof(pyvrp::Value)
@@ -24,6 +29,24 @@ template <typename T> struct type_caster<pyvrp::Matrix<T>>
 
     bool load(pybind11::handle src, bool convert)  // Python -> C++
     {
+        // Paths are taken to point to a matrix file, which is memory-mapped
+        // rather than read into memory.
+        if (pybind11::isinstance<pybind11::str>(src)
+            || pybind11::hasattr(src, "__fspath__"))
+        {
+            auto const os = pybind11::module_::import("os");
+            auto const path = os.attr("fspath")(src).cast<std::string>();
+            value = pyvrp::Matrix<T>::fromFile(path);
+            return true;
+        }
+
+        // Metrics compute the elements when needed, rather than storing them.
+        if (pybind11::isinstance<pyvrp::Metric>(src))
+        {
+            value = pyvrp::Matrix<T>::fromMetric(src.cast<pyvrp::Metric>());
+            return true;
+        }
+
         if (!convert && !pybind11::array_t<pyvrp::Value>::check_(src))
             return false;
 
@@ -37,8 +60,33 @@ template <typename T> struct type_caster<pyvrp::Matrix<T>>
         if (buf.size() == 0)  // then the default constructed object is already
             return true;      // OK, and we have nothing to do.
 
-        std::vector<T> data = {buf.data(), buf.data() + buf.size()};
-        value = pyvrp::Matrix<T>(data, buf.shape(0), buf.shape(1));
+        auto const nRows = buf.shape(0);
+        auto const nCols = buf.shape(1);
+        auto const *data = reinterpret_cast<T const *>(buf.data());
+
+        // Writeable arrays that were passed in may still be modified by the
+        // caller, which would silently change the matrix. We copy those.
+        // Read-only arrays, and arrays converted above, which are referenced
+        // nowhere else, are adopted instead.
+        if (buf.ptr() == src.ptr() && buf.writeable())
+        {
+            std::vector<T> elems(data, data + buf.size());
+            value = pyvrp::Matrix<T>(std::move(elems), nRows, nCols);
+            return true;
+        }
+
+        // The matrix adopts the array's buffer rather than copying it, and
+        // keeps a reference to the array for as long as the buffer is in use.
+        // That reference may be released without holding the GIL, so the
+        // deleter acquires it.
+        std::shared_ptr<void const> owner(
+            new pybind11::object(buf), [](pybind11::object *array) {
+                pybind11::gil_scoped_acquire gil;
+                delete array;
+            });
+
+        value = pyvrp::Matrix<T>::fromBuffer(
+            std::move(owner), data, nRows, nCols);
 
         return true;
     }
@@ -48,17 +96,57 @@ template <typename T> struct type_caster<pyvrp::Matrix<T>>
          [[maybe_unused]] pybind11::return_value_policy policy,
          pybind11::handle parent)
     {
+        auto const nRows = src.numRows();
+        auto const nCols = src.numCols();
         auto constexpr elemSize = sizeof(pyvrp::Value);
 
+        // Matrices are always returned as arrays of pyvrp::Value. Matrices
+        // that store such an array are viewed directly, and the view keeps
+        // the parent object alive.
+        if (src.isDense())
+        {
+            auto const *elems = reinterpret_cast<pyvrp::Value const *>(
+                src.data());
+            pybind11::array_t<pyvrp::Value> array
+                = {{nRows, nCols},                // shape
+                   {elemSize * nCols, elemSize},  // strides
+                   elems,                         // data
+                   parent};                       // base
+
+            return readOnly(std::move(array));
+        }
+
+        // Matrices that are narrowed, packed, relabelled, or computed by a
+        // metric have no such array to view. Their elements are unpacked into
+        // a temporary array that is owned by the returned array, and freed
+        // along with it. The matrix itself does not keep a copy.
+        auto unpacked = std::make_unique<std::vector<T>>();
+        unpacked->reserve(src.size());
+        for (size_t row = 0; row != nRows; ++row)
+            for (size_t col = 0; col != nCols; ++col)
+                unpacked->push_back(src(row, col));
+
+        auto const *elems
+            = reinterpret_cast<pyvrp::Value const *>(unpacked->data());
+        pybind11::capsule owner(unpacked.release(), [](void *ptr) {
+            delete static_cast<std::vector<T> *>(ptr);
+        });
+
         pybind11::array_t<pyvrp::Value> array
-            = {{src.numRows(), src.numCols()},                      // shape
-               {elemSize * src.numCols(), elemSize},                // strides
-               reinterpret_cast<pyvrp::Value const *>(src.data()),  // data
-               parent};                                             // base
-
-        // This is not pretty, but it makes the matrix non-writeable on the
-        // Python side. That's needed because src is const, and we should
-        // preserve that to avoid issues.
+            = {{nRows, nCols},                // shape
+               {elemSize * nCols, elemSize},  // strides
+               elems,                         // data
+               owner};                        // base
+
+        return readOnly(std::move(array));
+    }
+
+private:
+    // This is not pretty, but it makes the matrix non-writeable on the Python
+    // side. That's needed because src is const, and we should preserve that
+    // to avoid issues.
+    static pybind11::handle readOnly(pybind11::array array)
+    {
         pybind11::detail::array_proxy(array.ptr())->flags
             &= ~pybind11::detail::npy_api::NPY_ARRAY_WRITEABLE_;
 
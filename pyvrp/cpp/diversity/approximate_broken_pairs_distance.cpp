@@ -0,0 +1,57 @@
+#include "diversity.h"
+
+#include <algorithm>
+
+double
+pyvrp::diversity::approximateBrokenPairsDistance(pyvrp::Solution const &first,
+                                                 pyvrp::Solution const &second)
+{
+    auto const &fSketch = first.sketch();
+    auto const &sSketch = second.sketch();
+
+    // The bottom-k sketch of the union of both sets consists of the k smallest
+    // hash values across both sketches. We walk these in ascending order, and
+    // count how many of them appear in both sketches. If neither sketch was
+    // truncated, the sketches are the full sets, and we can use all values.
+    auto const complete = fSketch.size() == 2 * first.numClients()
+                          && sSketch.size() == 2 * second.numClients();
+    auto const maxSeen = complete ? fSketch.size() + sSketch.size()
+                                  : Solution::SKETCH_SIZE;
+
+    size_t fIdx = 0;
+    size_t sIdx = 0;
+    size_t numSeen = 0;
+    size_t numShared = 0;
+
+    while (numSeen != maxSeen
+           && (fIdx != fSketch.size() || sIdx != sSketch.size()))
+    {
+        if (sIdx == sSketch.size()
+            || (fIdx != fSketch.size() && fSketch[fIdx] < sSketch[sIdx]))
+            fIdx++;
+        else if (fIdx == fSketch.size() || sSketch[sIdx] < fSketch[fIdx])
+            sIdx++;
+        else  // hash value is in both sketches
+        {
+            fIdx++;
+            sIdx++;
+            numShared++;
+        }
+
+        numSeen++;
+    }
+
+    if (numSeen == 0)  // both solutions are empty, and thus the same
+        return 0.0;
+
+    // Estimate the size of the symmetric difference of both sets from the
+    // Jaccard similarity and the set sizes. Each client contributes two
+    // elements. When both solutions visit the same clients, the number of
+    // broken pairs is exactly half the size of the symmetric difference.
+    auto const jaccard = static_cast<double>(numShared) / numSeen;
+    auto const numElements = 2.0 * (first.numClients() + second.numClients());
+    auto const symDiff = numElements * (1 - jaccard) / (1 + jaccard);
+
+    size_t const numLocations = first.predecessors().size();
+    return std::min(symDiff / 2 / (2. * numLocations), 1.0);
+}
@@ -12,4 +12,10 @@ PYBIND11_MODULE(_diversity, m)
           py::arg("first"),
           py::arg("second"),
           DOC(pyvrp, diversity, brokenPairsDistance));
+
+    m.def("approximate_broken_pairs_distance",
+          &pyvrp::diversity::approximateBrokenPairsDistance,
+          py::arg("first"),
+          py::arg("second"),
+          DOC(pyvrp, diversity, approximateBrokenPairsDistance));
 }
@@ -1,31 +1,75 @@
 #include "diversity.h"
 
-#include <limits>
+#include <cstdint>
+#include <span>
 
-double pyvrp::diversity::brokenPairsDistance(pyvrp::Solution const &first,
-                                             pyvrp::Solution const &second)
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define PYVRP_HAS_AVX2_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace
 {
-    auto const &fNeighbours = first.getNeighbours();
-    auto const &sNeighbours = second.getNeighbours();
+// Counts the number of positions at which the given arrays differ.
+size_t countMismatches(uint32_t const *first, uint32_t const *second, size_t n)
+{
+    size_t count = 0;
+    for (size_t idx = 0; idx != n; ++idx)
+        count += first[idx] != second[idx];
+
+    return count;
+}
 
-    size_t const numLocations = fNeighbours.size();
-    size_t numBrokenPairs = 0;
+#ifdef PYVRP_HAS_AVX2_DISPATCH
+// Same as countMismatches(), but compares eight elements at a time. This is
+// only called when the CPU we are running on supports AVX2.
+__attribute__((target("avx2,popcnt"))) size_t
+countMismatchesAVX2(uint32_t const *first, uint32_t const *second, size_t n)
+{
+    size_t count = 0;
+    size_t idx = 0;
 
-    for (size_t location = 0; location != numLocations; location++)
+    for (; idx + 8 <= n; idx += 8)
     {
-        // Large default in case a location is not in one of the solutions.
-        size_t constexpr max = std::numeric_limits<size_t>::max();
-        std::pair<size_t, size_t> constexpr unassigned = {max, max};
-
-        auto const [fPred, fSucc] = fNeighbours[location].value_or(unassigned);
-        auto const [sPred, sSucc] = sNeighbours[location].value_or(unassigned);
+        auto const *fPtr = reinterpret_cast<__m256i const *>(first + idx);
+        auto const *sPtr = reinterpret_cast<__m256i const *>(second + idx);
 
-        // An edge pair (fPred, location) or (location, fSucc) from the first
-        // solution is broken if it is not in the second solution.
-        numBrokenPairs += fSucc != sSucc;
-        numBrokenPairs += fPred != sPred;
+        auto const equal = _mm256_cmpeq_epi32(_mm256_loadu_si256(fPtr),
+                                              _mm256_loadu_si256(sPtr));
+        auto const mask = _mm256_movemask_ps(_mm256_castsi256_ps(equal));
+        count += 8 - _mm_popcnt_u32(static_cast<unsigned>(mask));
     }
 
+    return count + countMismatches(first + idx, second + idx, n - idx);
+}
+#endif
+
+size_t numMismatches(std::span<uint32_t const> first,
+                     std::span<uint32_t const> second)
+{
+#ifdef PYVRP_HAS_AVX2_DISPATCH
+    static bool const hasAVX2 = __builtin_cpu_supports("avx2")
+                                && __builtin_cpu_supports("popcnt");
+
+    if (hasAVX2)
+        return countMismatchesAVX2(first.data(), second.data(), first.size());
+#endif
+
+    return countMismatches(first.data(), second.data(), first.size());
+}
+}  // namespace
+
+double pyvrp::diversity::brokenPairsDistance(pyvrp::Solution const &first,
+                                             pyvrp::Solution const &second)
+{
+    // Locations that are not in a solution have sentinel predecessor and
+    // successor values. An edge pair (pred, location) or (location, succ)
+    // from the first solution is broken if it is not in the second solution.
+    size_t const numLocations = first.predecessors().size();
+    size_t const numBrokenPairs
+        = numMismatches(first.predecessors(), second.predecessors())
+          + numMismatches(first.successors(), second.successors());
+
     // numBrokenPairs is at most 2n since we can count at most two broken edges
     // for each location. Here, we normalise the distance to [0, 1].
     return numBrokenPairs / (2. * numLocations);
@@ -57,6 +57,38 @@ typedef std::function<double(Solution const &, Solution const &)>
  *     maximally diverse, a value of zero indicates they are the same.
  */
 double brokenPairsDistance(Solution const &first, Solution const &second);
+
+/**
+ * Computes an approximation of the broken pairs distance between the given two
+ * solutions. Each solution stores a bottom-:math:`k` MinHash sketch of the
+ * (predecessor, location) and (location, successor) pairs of the clients it
+ * visits. From these sketches, the Jaccard similarity :math:`J` of the two
+ * sets of pairs is estimated in :math:`O(k)` time, independent of the number
+ * of locations. The number of broken pairs is then estimated from :math:`J`
+ * and the sizes of both sets.
+ *
+ * The estimate's standard error in :math:`J` is roughly
+ * :math:`1 / \sqrt{k}`, with :math:`k = 128`. When both solutions visit the
+ * same clients, and there are at most :math:`k / 2` such clients, the result
+ * is exact.
+ * This measure is mostly useful for very large instances, where the exact
+ * broken pairs distance becomes expensive to compute.
+ *
+ * Parameters
+ * ----------
+ * first
+ *     First solution.
+ * second
+ *     Second solution.
+ *
+ * Returns
+ * -------
+ * float
+ *     A value in [0, 1] that approximates the broken pairs distance between
+ *     the two solutions.
+ */
+double approximateBrokenPairsDistance(Solution const &first,
+                                      Solution const &second);
 }  // namespace pyvrp::diversity
 
 #endif  // PYVRP_DIVERSITY_H
@@ -0,0 +1,437 @@
+#include "instance_file.h"
+#include "Bytes.h"
+#include "MappedFile.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+using pyvrp::Distance;
+using pyvrp::Duration;
+using pyvrp::MappedFile;
+using pyvrp::Matrix;
+using pyvrp::Metric;
+using pyvrp::Neighbours;
+using pyvrp::ProblemData;
+using pyvrp::ReplacementFile;
+
+namespace
+{
+// Data parts are aligned to this many bytes in the file, so that matrices can
+// be used directly from the mapping.
+constexpr size_t ALIGNMENT = 64;
+
+size_t aligned(size_t size)
+{
+    return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+// Collects the data parts of an instance file, each of which starts at an
+// aligned offset relative to the first part.
+class Parts
+{
+    struct Part
+    {
+        char const *data;
+        size_t size;
+    };
+
+    std::vector<Part> parts_;
+    size_t size_ = 0;
+
+public:
+    // Adds count elements starting at data, and returns their offset. The
+    // elements must outlive this object.
+    template <typename T> size_t add(T const *data, size_t count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        auto const offset = size_;
+        parts_.push_back({reinterpret_cast<char const *>(data),
+                          count * sizeof(T)});
+        size_ = aligned(offset + count * sizeof(T));
+        return offset;
+    }
+
+    void write(std::ostream &out) const
+    {
+        std::string const padding(ALIGNMENT, '\0');
+        for (auto const &[data, size] : parts_)
+        {
+            out.write(data, static_cast<std::streamsize>(size));
+            auto const pad = aligned(size) - size;
+            out.write(padding.data(), static_cast<std::streamsize>(pad));
+        }
+    }
+};
+
+// Describes where and how a matrix is stored in an instance file.
+struct MatrixLayout
+{
+    Metric const *metric = nullptr;  // set if the matrix is computed
+    void const *elems = nullptr;     // first stored element in memory
+    uint8_t width = 0;
+    bool packed = false;
+    std::vector<uint32_t> const *slots = nullptr;
+    size_t slotsOffset = 0;
+    size_t elemsOffset = 0;
+};
+
+template <typename T>
+MatrixLayout layoutOf(Matrix<T> const &matrix,
+                      Parts &parts,
+                      MatrixLayout const *other = nullptr)
+{
+    MatrixLayout layout;
+    if ((layout.metric = matrix.metric()))
+        return layout;
+
+    matrix.visit([&](auto const *elems) {
+        layout.elems = elems;
+        layout.width = sizeof(*elems);
+    });
+
+    layout.packed = matrix.isPacked();
+    layout.slots = matrix.slots();
+
+    // A matrix that shares its storage with the other matrix (typically the
+    // duration and distance matrices) is written only once.
+    if (other && layout.elems == other->elems && layout.width == other->width
+        && layout.packed == other->packed
+        && (layout.slots == other->slots
+            || (layout.slots && other->slots
+                && *layout.slots == *other->slots)))
+        return *other;
+
+    if (layout.slots)
+        layout.slotsOffset = parts.add(layout.slots->data(),
+                                       layout.slots->size());
+
+    matrix.visit([&](auto const *elems) {
+        layout.elemsOffset = parts.add(elems, matrix.storedSize());
+    });
+
+    return layout;
+}
+
+template <typename T>
+void writeLayout(pyvrp::ByteWriter &writer,
+                 Matrix<T> const &matrix,
+                 MatrixLayout const &layout,
+                 size_t base)
+{
+    writer.write<uint64_t>(matrix.numRows());
+    writer.write<uint64_t>(matrix.numCols());
+
+    if (layout.metric)  // computed matrices are written as their metric
+    {
+        writer.write<uint8_t>(0);
+        writer.writeString(layout.metric->kind());
+        writer.write(layout.metric->scale());
+        writer.write(layout.metric->degreesPerUnit());
+        return;
+    }
+
+    writer.write<uint8_t>(layout.width);
+    writer.write<uint8_t>(layout.packed);
+    writer.write<uint64_t>(layout.slots ? layout.slots->size() : 0);
+    writer.write<uint64_t>(base + layout.slotsOffset);
+    writer.write<uint64_t>(base + layout.elemsOffset);
+}
+
+// Copies count elements at the given offset out of the file.
+template <typename T>
+std::vector<T> readPart(MappedFile const &file, uint64_t offset, size_t count)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    if (offset > file.size() || count > (file.size() - offset) / sizeof(T))
+        throw std::invalid_argument("File is too short to contain data.");
+
+    std::vector<T> part(count);
+    std::memcpy(part.data(), file.data() + offset, count * sizeof(T));
+    return part;
+}
+
+template <typename T>
+Matrix<T> readLayout(pyvrp::ByteReader &reader,
+                     std::shared_ptr<MappedFile const> const &file)
+{
+    auto const numRows = reader.read<uint64_t>();
+    auto const numCols = reader.read<uint64_t>();
+    auto const width = reader.read<uint8_t>();
+
+    if (width == 0)  // computed by a metric
+    {
+        auto const kind = reader.readString();
+        auto const scale = reader.read<double>();
+        auto const degreesPerUnit = reader.read<double>();
+        return Matrix<T>::fromMetric(Metric(kind, scale, degreesPerUnit));
+    }
+
+    auto const packed = reader.read<uint8_t>();
+    auto const numSlots = reader.read<uint64_t>();
+    auto const slotsOffset = reader.read<uint64_t>();
+    auto const elemsOffset = reader.read<uint64_t>();
+    auto slots = readPart<uint32_t>(*file, slotsOffset, numSlots);
+
+    return Matrix<T>::fromMapped(file,
+                                 elemsOffset,
+                                 width,
+                                 packed,
+                                 std::move(slots),
+                                 numRows,
+                                 numCols);
+}
+}  // namespace
+
+void pyvrp::writeInstanceFile(std::string const &path,
+                              ProblemData const &data,
+                              std::optional<Neighbours> const &neighbours)
+{
+    auto const numLocs = data.numLocations();
+
+    // Neighbours are stored as offsets into a single array of indices, such
+    // that the neighbours of location i are indices[offsets[i]:offsets[i + 1]].
+    std::vector<uint64_t> offsets;
+    std::vector<uint64_t> indices;
+    if (neighbours)
+    {
+        if (neighbours->size() != numLocs)
+            throw std::invalid_argument("Neighbourhood dimensions do not match "
+                                        "the number of locations.");
+
+        offsets.push_back(0);
+        for (auto const &locNeighbours : *neighbours)
+        {
+            for (auto const neighbour : locNeighbours)
+            {
+                if (neighbour >= numLocs)
+                    throw std::invalid_argument("Neighbour out of range.");
+
+                indices.push_back(neighbour);
+            }
+
+            offsets.push_back(indices.size());
+        }
+    }
+
+    Parts parts;
+
+    auto const &attrs = data.attributes();
+    size_t const attrOffsets[] = {
+        parts.add(attrs.x.data(), numLocs),
+        parts.add(attrs.y.data(), numLocs),
+        parts.add(attrs.delivery.data(), numLocs),
+        parts.add(attrs.pickup.data(), numLocs),
+        parts.add(attrs.serviceDuration.data(), numLocs),
+        parts.add(attrs.twEarly.data(), numLocs),
+        parts.add(attrs.twLate.data(), numLocs),
+        parts.add(attrs.releaseTime.data(), numLocs),
+        parts.add(attrs.prize.data(), numLocs),
+    };
+
+    std::vector<uint8_t> required;
+    required.reserve(data.numClients());
+    for (auto const &client : data.clients())
+        required.push_back(client.required);
+
+    auto const requiredOffset = parts.add(required.data(), required.size());
+
+    auto const &distMat = data.distanceMatrix();
+    auto const &durMat = data.durationMatrix();
+    auto const distLayout = layoutOf(distMat, parts);
+    auto const durLayout = layoutOf(durMat, parts, &distLayout);
+
+    auto const offsetsOffset = parts.add(offsets.data(), offsets.size());
+    auto const indicesOffset = parts.add(indices.data(), indices.size());
+
+    // The descriptor points to the data parts that follow it. Its size does
+    // not depend on where these parts start, so we can describe the file once
+    // to determine that, and then again with the actual offsets.
+    auto const describe = [&](size_t base) {
+        ByteWriter writer(INSTANCE_FILE_FORMAT);
+        writer.write<uint64_t>(data.numDepots());
+        writer.write<uint64_t>(data.numClients());
+
+        for (auto const offset : attrOffsets)
+            writer.write<uint64_t>(base + offset);
+
+        writer.write<uint64_t>(base + requiredOffset);
+
+        for (auto const &depot : data.depots())
+            writer.writeString(depot.name);
+
+        for (auto const &client : data.clients())
+            writer.writeString(client.name);
+
+        writer.write<uint64_t>(data.numVehicleTypes());
+        for (auto const &vehicleType : data.vehicleTypes())
+        {
+            writer.write<uint64_t>(vehicleType.numAvailable);
+            writer.write(vehicleType.capacity);
+            writer.write<uint64_t>(vehicleType.depot);
+            writer.write(vehicleType.fixedCost);
+            writer.write(vehicleType.twEarly);
+            writer.write(vehicleType.twLate);
+            writer.write(vehicleType.maxDuration);
+            writer.writeString(vehicleType.name);
+        }
+
+        writeLayout(writer, distMat, distLayout, base);
+        writeLayout(writer, durMat, durLayout, base);
+
+        writer.write<uint8_t>(neighbours.has_value());
+        writer.write<uint64_t>(base + offsetsOffset);
+        writer.write<uint64_t>(base + indicesOffset);
+        writer.write<uint64_t>(indices.size());
+
+        return writer.release();
+    };
+
+    auto descriptor = describe(0);
+    auto const base = aligned(descriptor.size());
+    descriptor = describe(base);
+    descriptor.resize(base, '\0');
+
+    // The file is replaced only once it is complete, so that instances that
+    // still map the file being overwritten remain valid.
+    ReplacementFile file(path);
+    auto &out = file.stream();
+    out.write(descriptor.data(), static_cast<std::streamsize>(base));
+    parts.write(out);
+
+    if (!out)
+        throw std::runtime_error("Could not write instance file.");
+
+    file.commit();
+}
+
+std::pair<ProblemData, std::optional<Neighbours>>
+pyvrp::readInstanceFile(std::string const &path)
+{
+    auto const file = std::make_shared<MappedFile const>(path);
+    ByteReader reader({file->data(), file->size()}, INSTANCE_FILE_FORMAT);
+
+    auto const numDepots = reader.read<uint64_t>();
+    auto const numClients = reader.read<uint64_t>();
+    if (numClients > std::numeric_limits<uint64_t>::max() - numDepots)
+        throw std::invalid_argument("Invalid number of locations.");
+
+    auto const numLocs = numDepots + numClients;
+    auto const x
+        = readPart<Coordinate>(*file, reader.read<uint64_t>(), numLocs);
+    auto const y
+        = readPart<Coordinate>(*file, reader.read<uint64_t>(), numLocs);
+    auto const delivery
+        = readPart<Load>(*file, reader.read<uint64_t>(), numLocs);
+    auto const pickup = readPart<Load>(*file, reader.read<uint64_t>(), numLocs);
+    auto const serviceDuration
+        = readPart<Duration>(*file, reader.read<uint64_t>(), numLocs);
+    auto const twEarly
+        = readPart<Duration>(*file, reader.read<uint64_t>(), numLocs);
+    auto const twLate
+        = readPart<Duration>(*file, reader.read<uint64_t>(), numLocs);
+    auto const releaseTime
+        = readPart<Duration>(*file, reader.read<uint64_t>(), numLocs);
+    auto const prize = readPart<Cost>(*file, reader.read<uint64_t>(), numLocs);
+    auto const required
+        = readPart<uint8_t>(*file, reader.read<uint64_t>(), numClients);
+
+    std::vector<ProblemData::Depot> depots;
+    depots.reserve(numDepots);
+    for (size_t idx = 0; idx != numDepots; ++idx)
+    {
+        auto const name = reader.readString();
+        depots.emplace_back(
+            x[idx], y[idx], twEarly[idx], twLate[idx], name.c_str());
+    }
+
+    std::vector<ProblemData::Client> clients;
+    clients.reserve(numClients);
+    for (size_t idx = numDepots; idx != numLocs; ++idx)
+    {
+        auto const name = reader.readString();
+        clients.emplace_back(x[idx],
+                             y[idx],
+                             delivery[idx],
+                             pickup[idx],
+                             serviceDuration[idx],
+                             twEarly[idx],
+                             twLate[idx],
+                             releaseTime[idx],
+                             prize[idx],
+                             required[idx - numDepots],
+                             name.c_str());
+    }
+
+    std::vector<ProblemData::VehicleType> vehicleTypes;
+    auto const numVehicleTypes = reader.read<uint64_t>();
+    for (size_t idx = 0; idx != numVehicleTypes; ++idx)
+    {
+        auto const numAvailable = reader.read<uint64_t>();
+        auto const capacity = reader.read<Load>();
+        auto const depot = reader.read<uint64_t>();
+        auto const fixedCost = reader.read<Cost>();
+        auto const vehTwEarly = reader.read<Duration>();
+        auto const vehTwLate = reader.read<Duration>();
+        auto const maxDuration = reader.read<Duration>();
+        auto const name = reader.readString();
+
+        vehicleTypes.emplace_back(numAvailable,
+                                  capacity,
+                                  depot,
+                                  fixedCost,
+                                  vehTwEarly,
+                                  vehTwLate,
+                                  maxDuration,
+                                  name.c_str());
+    }
+
+    auto distMat = readLayout<Distance>(reader, file);
+    auto durMat = readLayout<Duration>(reader, file);
+
+    auto const hasNeighbours = reader.read<uint8_t>();
+    auto const offsetsOffset = reader.read<uint64_t>();
+    auto const indicesOffset = reader.read<uint64_t>();
+    auto const numIndices = reader.read<uint64_t>();
+
+    std::optional<Neighbours> neighbours;
+    if (hasNeighbours)
+    {
+        auto const offsets
+            = readPart<uint64_t>(*file, offsetsOffset, numLocs + 1);
+        auto const indices
+            = readPart<uint64_t>(*file, indicesOffset, numIndices);
+
+        if (offsets.front() != 0 || offsets.back() != numIndices)
+            throw std::invalid_argument("Invalid neighbours.");
+
+        neighbours.emplace(numLocs);
+        for (size_t loc = 0; loc != numLocs; ++loc)
+        {
+            if (offsets[loc] > offsets[loc + 1])
+                throw std::invalid_argument("Invalid neighbours.");
+
+            auto &locNeighbours = (*neighbours)[loc];
+            locNeighbours.assign(indices.begin() + offsets[loc],
+                                 indices.begin() + offsets[loc + 1]);
+
+            for (auto const neighbour : locNeighbours)
+                if (neighbour >= numLocs)
+                    throw std::invalid_argument("Invalid neighbours.");
+        }
+    }
+
+    ProblemData data(clients,
+                     depots,
+                     vehicleTypes,
+                     std::move(distMat),
+                     std::move(durMat));
+
+    return {std::move(data), std::move(neighbours)};
+}
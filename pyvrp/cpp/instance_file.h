@@ -0,0 +1,86 @@
+#ifndef PYVRP_INSTANCE_FILE_H
+#define PYVRP_INSTANCE_FILE_H
+
+#include "ProblemData.h"
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pyvrp
+{
+// Neighbours of each location, as used by the local search.
+using Neighbours = std::vector<std::vector<size_t>>;
+
+/**
+ * write_instance_file(
+ *     path: Union[str, os.PathLike],
+ *     data: ProblemData,
+ *     neighbours: Optional[list[list[int]]] = None,
+ * )
+ *
+ * Writes the given problem instance to a binary instance file at the given
+ * path, optionally together with precomputed neighbour lists. Such a file can
+ * be read again by :func:`~read_instance_file` in a fraction of the time it
+ * takes to read and process the original instance. Location data is stored
+ * per attribute, and matrices as they are stored in memory, such that reading
+ * the file requires no further processing.
+ *
+ * Parameters
+ * ----------
+ * path
+ *     Path of the instance file to write.
+ * data
+ *     Problem instance to write.
+ * neighbours
+ *     Optional neighbours of each location, as computed by
+ *     :func:`~pyvrp.search.neighbourhood.compute_neighbours`.
+ *
+ * Raises
+ * ------
+ * ValueError
+ *     When the neighbours are not given for each location, or refer to
+ *     locations that do not exist.
+ * RuntimeError
+ *     When the file could not be written.
+ */
+void writeInstanceFile(std::string const &path,
+                       ProblemData const &data,
+                       std::optional<Neighbours> const &neighbours
+                       = std::nullopt);
+
+/**
+ * read_instance_file(
+ *     path: Union[str, os.PathLike],
+ * ) -> tuple[ProblemData, Optional[list[list[int]]]]
+ *
+ * Reads a binary instance file, as written by :func:`~write_instance_file`.
+ * The file is memory-mapped, and its matrices are used directly from the
+ * mapping, without copying them. The file must thus not be modified while the
+ * returned instance is in use.
+ *
+ * Parameters
+ * ----------
+ * path
+ *     Path of the instance file to read.
+ *
+ * Returns
+ * -------
+ * tuple
+ *     The problem instance, and its neighbours if these were written to the
+ *     file, or ``None`` otherwise.
+ *
+ * Raises
+ * ------
+ * ValueError
+ *     When the file is not a valid instance file, or was written by a
+ *     different version of PyVRP, or by a build with a different precision.
+ * RuntimeError
+ *     When the file could not be opened.
+ */
+std::pair<ProblemData, std::optional<Neighbours>>
+readInstanceFile(std::string const &path);
+}  // namespace pyvrp
+
+#endif  // PYVRP_INSTANCE_FILE_H
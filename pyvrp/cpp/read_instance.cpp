@@ -0,0 +1,686 @@
+#include "read_instance.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+using pyvrp::Distance;
+using pyvrp::Duration;
+using pyvrp::Matrix;
+using pyvrp::ProblemData;
+using pyvrp::Value;
+
+namespace
+{
+// Minimum number of edge weights before these are computed on multiple
+// threads. Below this, the overhead of starting the threads outweighs the
+// gains.
+size_t constexpr PARALLEL_THRESHOLD = 250'000;
+
+// Same as pyvrp.constants.MAX_VALUE. The Python reader warns about edge
+// weights larger than this, so we leave such instances to it.
+double constexpr MAX_VALUE = 1LL << 52;
+
+// Integers up to this magnitude are exactly representable as doubles.
+double constexpr MAX_EXACT = 1LL << 53;
+
+// Default value of missing capacities, maximum durations, and time windows,
+// as in pyvrp.read.read().
+Value const MAX_INT = static_cast<Value>(std::numeric_limits<int64_t>::max());
+
+// The rounding functions of pyvrp.read.ROUND_FUNCS.
+enum class Rounding
+{
+    ROUND,
+    TRUNC,
+    TRUNC1,
+    NONE,
+};
+
+// Number as given in the file. Python parses integers and other numbers
+// differently, and we need to know which of the two it would have done.
+struct Number
+{
+    double value;
+    bool isInt;
+};
+
+// Rows of a data section, without the leading index column.
+struct Table
+{
+    size_t numRows = 0;
+    size_t numCols = 0;
+    std::vector<Number> data = {};
+
+    Number operator()(size_t row, size_t col) const
+    {
+        return data[row * numCols + col];
+    }
+};
+
+// The parts of an instance that pyvrp.read.read() uses.
+struct Instance
+{
+    size_t dimension = 0;
+    std::optional<size_t> numVehicles;
+    std::optional<Number> capacity;
+    std::optional<Number> maxDuration;
+    std::optional<Number> serviceTime;  // uniform service time, if given
+    std::vector<size_t> depots = {0};
+    std::unordered_map<std::string, Table> sections;
+
+    // Edge weights are either computed from the node coordinates, or given
+    // explicitly, one row per line.
+    bool isEuclidean = false;
+    std::vector<std::string_view> edgeWeightRows;
+};
+
+[[noreturn]] void unsupported(std::string const &what)
+{
+    throw pyvrp::UnsupportedInstanceError(what);
+}
+
+Rounding toRounding(std::string const &roundFunc)
+{
+    if (roundFunc == "round")
+        return Rounding::ROUND;
+    if (roundFunc == "trunc")
+        return Rounding::TRUNC;
+    if (roundFunc == "trunc1" || roundFunc == "dimacs")
+        return Rounding::TRUNC1;
+    if (roundFunc == "none")
+        return Rounding::NONE;
+
+    unsupported("Unknown rounding function " + roundFunc + '.');
+}
+
+bool isSpace(char chr) { return std::isspace(static_cast<unsigned char>(chr)); }
+
+std::string lower(std::string_view text)
+{
+    std::string result(text);
+    for (auto &chr : result)
+        chr = std::tolower(static_cast<unsigned char>(chr));
+
+    return result;
+}
+
+std::string_view strip(std::string_view text)
+{
+    while (!text.empty() && isSpace(text.front()))
+        text.remove_prefix(1);
+
+    while (!text.empty() && isSpace(text.back()))
+        text.remove_suffix(1);
+
+    return text;
+}
+
+// Removes the next whitespace-separated word from the given line, and returns
+// it. Returns an empty word once the line is exhausted.
+std::string_view nextWord(std::string_view &line)
+{
+    line = strip(line);
+
+    auto const end = std::find_if(line.begin(), line.end(), isSpace);
+    auto const word = line.substr(0, end - line.begin());
+    line.remove_prefix(word.size());
+    return word;
+}
+
+// Returns whether the given (stripped) line marks the end of the file.
+bool isEnd(std::string_view line) { return line == "EOF"; }
+
+// Returns the name of the section that is started by the given line, or an
+// empty name when the line does not start a section. Section headers start
+// with a word of the form "<NAME>_SECTION".
+std::string_view sectionName(std::string_view line)
+{
+    auto constexpr suffix = std::string_view("_SECTION");
+
+    auto const header = nextWord(line);
+    if (header.size() <= suffix.size() || !header.ends_with(suffix))
+        return {};
+
+    return header.substr(0, header.size() - suffix.size());
+}
+
+// Stripped lines of the given text, skipping empty lines and comments.
+std::vector<std::string_view> toLines(std::string_view text)
+{
+    std::vector<std::string_view> lines;
+
+    while (!text.empty())
+    {
+        auto const end = std::min(text.find('\n'), text.size());
+        auto const line = strip(text.substr(0, end));
+        text.remove_prefix(std::min(end + 1, text.size()));
+
+        if (!line.empty() && line.front() != '#')
+            lines.push_back(line);
+    }
+
+    return lines;
+}
+
+std::optional<Number> toNumber(std::string_view word)
+{
+    if (word.starts_with('+'))  // Python allows an explicit plus sign, but
+        word.remove_prefix(1);  // from_chars() does not.
+
+    if (word.empty() || word.front() == '+')
+        return std::nullopt;
+
+    auto const *first = word.data();
+    auto const *last = first + word.size();
+
+    int64_t integer;
+    auto const [intEnd, intErr] = std::from_chars(first, last, integer);
+    if (intErr == std::errc() && intEnd == last)
+        return Number{static_cast<double>(integer), true};
+
+    double value;
+    auto const [end, err] = std::from_chars(first, last, value);
+    if (err == std::errc() && end == last)
+        return Number{value, false};
+
+    return std::nullopt;
+}
+
+Number parseNumber(std::string_view word)
+{
+    if (auto const number = toNumber(word))
+        return *number;
+
+    unsupported("Could not parse '" + std::string(word) + "' as a number.");
+}
+
+size_t parseCount(std::string_view word)
+{
+    auto const number = parseNumber(word);
+    if (!number.isInt || number.value < 0)
+        unsupported("Expected a non-negative integer.");
+
+    return static_cast<size_t>(number.value);
+}
+
+// Applies the given rounding function. The (truncating) conversion to Value
+// happens separately, as it does when numpy arrays are passed to PyVRP.
+double rounded(double value, Rounding rounding)
+{
+    if (rounding == Rounding::ROUND)  // rounds half to even, like np.round()
+        return std::nearbyint(value);
+
+    if (rounding == Rounding::TRUNC)
+        return std::trunc(value);
+
+    if (rounding == Rounding::TRUNC1)
+        return std::trunc(10 * value);
+
+    return value;
+}
+
+// Converts a data value, as pyvrp.read.read() does. With integer precision,
+// unrounded values must be integers, since Python does not accept anything
+// else for PyVRP's data fields.
+Value toValue(Number number, Rounding rounding)
+{
+    if constexpr (std::is_integral_v<Value>)
+        if (rounding == Rounding::NONE && !number.isInt)
+            unsupported("Data must be integral when it is not rounded.");
+
+    auto const value = rounded(number.value, rounding);
+    if (!(std::abs(value) <= MAX_EXACT))
+        unsupported("Data value is too large.");
+
+    return static_cast<Value>(value);
+}
+
+// Parses the rows of a data section. Each row must have the given number of
+// columns, including the leading index column, which is dropped.
+Table parseTable(std::vector<std::string_view> const &rows, size_t numCols)
+{
+    Table table = {rows.size(), numCols - 1};
+    table.data.reserve(table.numRows * table.numCols);
+
+    for (auto row : rows)
+    {
+        nextWord(row);  // index column
+        for (size_t col = 1; col != numCols; ++col)
+            table.data.push_back(parseNumber(nextWord(row)));
+
+        if (!nextWord(row).empty())
+            unsupported("Data section row has too many columns.");
+    }
+
+    return table;
+}
+
+// Calls fn(begin, end) on consecutive ranges of rows that together cover all
+// rows. For large amounts of work, the ranges are processed on multiple
+// threads. The function must not throw.
+template <typename Fn>
+void forEachRows(size_t numRows, size_t work, Fn const &fn)
+{
+    auto const numThreads = std::min<size_t>(
+        std::thread::hardware_concurrency(), numRows);
+
+    if (work < PARALLEL_THRESHOLD || numThreads <= 1)
+    {
+        fn(0, numRows);
+        return;
+    }
+
+    std::vector<std::jthread> threads;
+    threads.reserve(numThreads);
+
+    auto const chunkSize = (numRows + numThreads - 1) / numThreads;
+    for (size_t begin = 0; begin < numRows; begin += chunkSize)
+    {
+        auto const end = std::min(begin + chunkSize, numRows);
+        threads.emplace_back(fn, begin, end);
+    }
+}  // threads are joined here, as they go out of scope
+
+// Computes the edge weights of the given instance. Distances and durations
+// are the same, since these instances do not contain separate duration data.
+std::pair<Matrix<Distance>, Matrix<Duration>>
+edgeWeights(Instance const &instance, Rounding rounding)
+{
+    auto const dim = instance.dimension;
+
+    Table const *coords = nullptr;
+    if (instance.isEuclidean)
+    {
+        auto const it = instance.sections.find("node_coord");
+        if (it == instance.sections.end())
+            unsupported("EUC_2D edge weights require node coordinates.");
+
+        coords = &it->second;
+    }
+    else if (instance.edgeWeightRows.size() != dim)
+        unsupported("Edge weight section should have a row per location.");
+
+    std::vector<Distance> weights(dim * dim);
+    std::atomic<bool> valid = true;
+
+    auto const computeRows = [&](size_t begin, size_t end) {
+        for (auto row = begin; row != end && valid; ++row)
+        {
+            auto line = coords ? std::string_view()
+                               : instance.edgeWeightRows[row];
+            for (size_t col = 0; col != dim; ++col)
+            {
+                double weight;
+                if (coords)
+                {
+                    auto const &xy = *coords;
+                    auto const dx = xy(row, 0).value - xy(col, 0).value;
+                    auto const dy = xy(row, 1).value - xy(col, 1).value;
+                    weight = std::sqrt(dx * dx + dy * dy);
+                }
+                else if (auto const number = toNumber(nextWord(line)))
+                    weight = number->value;
+                else  // not a number, or too few columns
+                {
+                    valid = false;
+                    return;
+                }
+
+                // Python warns about weights larger than MAX_VALUE, so we do
+                // not handle those here.
+                weight = rounded(weight, rounding);
+                if (!(std::abs(weight) <= MAX_VALUE))
+                {
+                    valid = false;
+                    return;
+                }
+
+                weights[row * dim + col] = weight;
+            }
+
+            if (!coords && !nextWord(line).empty())  // too many columns
+                valid = false;
+        }
+    };
+
+    forEachRows(dim, dim * dim, computeRows);
+
+    if (!valid)
+        unsupported("Could not compute all edge weights.");
+
+    // The durations are a copy of the distances. ProblemData compacts both
+    // matrices, and then stores the identical elements only once.
+    std::vector<Duration> durations;
+    durations.reserve(weights.size());
+    for (auto const weight : weights)
+        durations.push_back(static_cast<Duration>(weight));
+
+    return {Matrix<Distance>(std::move(weights), dim, dim),
+            Matrix<Duration>(std::move(durations), dim, dim)};
+}
+
+Instance parseVrplib(std::vector<std::string_view> const &lines)
+{
+    Instance instance;
+    std::optional<size_t> dimension;
+    std::string type;
+    std::string edgeWeightType;
+    std::string edgeWeightFormat;
+
+    // Each line is either a specification of the form "KEY : VALUE", or the
+    // start of a section that runs until the next section, or the end of the
+    // file. We only take the lines of each section here, and parse these
+    // once all specifications (in particular the dimension) are known.
+    std::unordered_map<std::string, std::vector<std::string_view>> sections;
+    for (size_t idx = 0; idx < lines.size(); ++idx)
+    {
+        auto const line = lines[idx];
+        if (isEnd(line))
+            break;
+
+        if (auto const name = sectionName(line); !name.empty())
+        {
+            auto end = idx + 1;
+            while (end < lines.size() && sectionName(lines[end]).empty()
+                   && !isEnd(lines[end]))
+                ++end;
+
+            sections[lower(name)]
+                = {lines.begin() + idx + 1, lines.begin() + end};
+            idx = end - 1;
+            continue;
+        }
+
+        auto const colon = line.find(':');
+        if (colon == std::string_view::npos)
+            unsupported("Could not parse line '" + std::string(line) + "'.");
+
+        auto const key = lower(strip(line.substr(0, colon)));
+        auto const value = strip(line.substr(colon + 1));
+
+        if (key == "dimension")
+            dimension = parseCount(value);
+        else if (key == "vehicles")
+            instance.numVehicles = parseCount(value);
+        else if (key == "capacity")
+            instance.capacity = parseNumber(value);
+        else if (key == "vehicles_max_duration")
+            instance.maxDuration = parseNumber(value);
+        else if (key == "service_time")
+            instance.serviceTime = parseNumber(value);
+        else if (key == "type")
+            type = value;
+        else if (key == "edge_weight_type")
+            edgeWeightType = value;
+        else if (key == "edge_weight_format")
+            edgeWeightFormat = value;
+    }
+
+    if (!dimension)
+        unsupported("Instance does not specify its dimension.");
+
+    // VRPB instances need their edge weights adjusted, which the Python
+    // reader does.
+    if (type == "VRPB")
+        unsupported("VRPB instances are not supported.");
+
+    instance.dimension = *dimension;
+    instance.isEuclidean = edgeWeightType == "EUC_2D";
+
+    if (!instance.isEuclidean
+        && (edgeWeightType != "EXPLICIT" || edgeWeightFormat != "FULL_MATRIX"))
+        unsupported("Edge weights must be EUC_2D or an EXPLICIT full matrix.");
+
+    for (auto const &[name, rows] : sections)
+    {
+        if (name == "edge_weight" && !instance.isEuclidean)
+            instance.edgeWeightRows = rows;
+        else if (name == "depot")
+        {
+            // Depot indices run until a -1, and start at one in the file.
+            instance.depots.clear();
+            for (auto row : rows)
+                for (auto word = nextWord(row); !word.empty();
+                     word = nextWord(row))
+                {
+                    auto const number = parseNumber(word);
+                    if (number.isInt && number.value == -1)
+                        continue;
+
+                    if (!number.isInt || number.value < 1)
+                        unsupported("Depot indices must be positive integers.");
+
+                    auto const depot = static_cast<size_t>(number.value);
+                    instance.depots.push_back(depot - 1);
+                }
+        }
+        else if (name == "vehicles_depot")
+            instance.sections[name] = parseTable(rows, 2);
+        else if (name == "node_coord" || name == "time_window")
+            instance.sections[name] = parseTable(rows, 3);
+        else if (name == "demand" || name == "linehaul" || name == "backhaul"
+                 || name == "service_time" || name == "release_time"
+                 || name == "prize")
+            instance.sections[name] = parseTable(rows, 2);
+        else
+            unsupported("Section " + name + " is not supported.");
+    }
+
+    for (auto const &[name, table] : instance.sections)
+        if (name != "vehicles_depot" && table.numRows != instance.dimension)
+            unsupported("Section " + name + " should have a row per location.");
+
+    return instance;
+}
+
+Instance parseSolomon(std::vector<std::string_view> const &lines)
+{
+    // The name, a vehicle header, a vehicle number and capacity header, the
+    // vehicle data, a customer header, the customer column names, and then
+    // one row per location.
+    if (lines.size() < 7)
+        unsupported("Solomon instance is incomplete.");
+
+    Instance instance;
+
+    auto vehicles = lines[3];
+    instance.numVehicles = parseCount(nextWord(vehicles));
+    instance.capacity = parseNumber(nextWord(vehicles));
+    if (!instance.capacity->isInt || !nextWord(vehicles).empty())
+        unsupported("Could not parse Solomon vehicle data.");
+
+    std::vector<std::string_view> const rows(lines.begin() + 6, lines.end());
+    auto const table = parseTable(rows, 7);
+    if (std::any_of(table.data.begin(), table.data.end(), [](auto number) {
+            return !number.isInt;
+        }))
+        unsupported("Solomon instance data must be integral.");
+
+    instance.dimension = table.numRows;
+    instance.isEuclidean = true;
+
+    // Columns are x, y, demand, ready time, due date, and service time.
+    auto const columns = [&](size_t first, size_t numCols) {
+        Table result = {table.numRows, numCols};
+        for (size_t row = 0; row != table.numRows; ++row)
+            for (size_t col = first; col != first + numCols; ++col)
+                result.data.push_back(table(row, col));
+
+        return result;
+    };
+
+    instance.sections["node_coord"] = columns(0, 2);
+    instance.sections["demand"] = columns(2, 1);
+    instance.sections["time_window"] = columns(3, 2);
+    instance.sections["service_time"] = columns(5, 1);
+
+    return instance;
+}
+
+ProblemData toProblemData(Instance const &instance, Rounding rounding)
+{
+    auto const dim = instance.dimension;
+    auto const &depotIdcs = instance.depots;
+
+    for (size_t idx = 0; idx != depotIdcs.size(); ++idx)
+        if (depotIdcs[idx] != idx)
+            unsupported("Depots should be in the contiguous lower indices.");
+
+    if (depotIdcs.empty() || depotIdcs.size() > dim)
+        unsupported("Instance should contain at least one depot.");
+
+    auto const table = [&](std::string const &name) -> Table const * {
+        auto const it = instance.sections.find(name);
+        return it == instance.sections.end() ? nullptr : &it->second;
+    };
+
+    // Returns the value in the given column of the named section, or the
+    // default value when the instance does not have such a section.
+    auto const value
+        = [&](Table const *data, size_t row, size_t col, Value dflt) {
+              return data ? toValue((*data)(row, col), rounding) : dflt;
+          };
+
+    auto const *coords = table("node_coord");
+    auto const *timeWindows = table("time_window");
+    auto const *demands = table("demand") ? table("demand") : table("linehaul");
+    auto const *backhauls = table("backhaul");
+    auto const *serviceTimes = table("service_time");
+    auto const *releaseTimes = table("release_time");
+    auto const *prizes = table("prize");
+
+    std::vector<ProblemData::Depot> depots;
+    depots.reserve(depotIdcs.size());
+    for (size_t idx = 0; idx != depotIdcs.size(); ++idx)
+        depots.emplace_back(value(coords, idx, 0, 0),
+                            value(coords, idx, 1, 0),
+                            value(timeWindows, idx, 0, 0),
+                            value(timeWindows, idx, 1, MAX_INT));
+
+    std::vector<ProblemData::Client> clients;
+    clients.reserve(dim - depotIdcs.size());
+    for (auto idx = depotIdcs.size(); idx != dim; ++idx)
+    {
+        // A uniform service time applies to all clients, unless the
+        // instance also has a service time section.
+        auto const serviceTime = instance.serviceTime && !serviceTimes
+                                     ? toValue(*instance.serviceTime, rounding)
+                                     : value(serviceTimes, idx, 0, 0);
+
+        Value const prize = value(prizes, idx, 0, 0);
+        clients.emplace_back(value(coords, idx, 0, 0),
+                             value(coords, idx, 1, 0),
+                             value(demands, idx, 0, 0),
+                             value(backhauls, idx, 0, 0),
+                             serviceTime,
+                             value(timeWindows, idx, 0, 0),
+                             value(timeWindows, idx, 1, MAX_INT),
+                             value(releaseTimes, idx, 0, 0),
+                             prize,
+                             std::abs(static_cast<double>(prize)) <= 1e-8);
+    }
+
+    // Each depot gets a vehicle type with the vehicles assigned to it. The
+    // type's name lists the (one-based) numbers of these vehicles.
+    std::vector<std::vector<size_t>> depotVehicles;
+    if (auto const *vehiclesDepot = table("vehicles_depot"))
+    {
+        depotVehicles.resize(depotIdcs.size());
+        for (size_t row = 0; row != vehiclesDepot->numRows; ++row)
+        {
+            auto const depot = (*vehiclesDepot)(row, 0);
+            if (!depot.isInt || depot.value < 1
+                || depot.value > depotIdcs.size())
+                unsupported("Vehicle assigned to unknown depot.");
+
+            auto const depotIdx = static_cast<size_t>(depot.value) - 1;
+            depotVehicles[depotIdx].push_back(row + 1);
+        }
+    }
+    else
+    {
+        depotVehicles.resize(1);
+        auto const numVehicles = instance.numVehicles.value_or(dim - 1);
+        for (size_t vehicle = 1; vehicle <= numVehicles; ++vehicle)
+            depotVehicles[0].push_back(vehicle);
+    }
+
+    auto const capacity = instance.capacity
+                              ? toValue(*instance.capacity, rounding)
+                              : MAX_INT;
+    auto const maxDuration = instance.maxDuration
+                                 ? toValue(*instance.maxDuration, rounding)
+                                 : MAX_INT;
+
+    std::vector<ProblemData::VehicleType> vehicleTypes;
+    vehicleTypes.reserve(depotVehicles.size());
+    for (size_t depot = 0; depot != depotVehicles.size(); ++depot)
+    {
+        std::string name;
+        for (auto const vehicle : depotVehicles[depot])
+            name += (name.empty() ? "" : ",") + std::to_string(vehicle);
+
+        vehicleTypes.emplace_back(depotVehicles[depot].size(),
+                                  capacity,
+                                  depot,
+                                  0,
+                                  0,
+                                  std::numeric_limits<Duration>::max(),
+                                  maxDuration,
+                                  name.c_str());
+    }
+
+    auto [distances, durations] = edgeWeights(instance, rounding);
+    return {clients,
+            depots,
+            vehicleTypes,
+            std::move(distances),
+            std::move(durations)};
+}
+
+std::unique_ptr<pyvrp::MappedFile const> openFile(std::string const &path)
+{
+    try
+    {
+        return std::make_unique<pyvrp::MappedFile const>(path);
+    }
+    catch (std::runtime_error const &error)
+    {
+        // Files that cannot be mapped, such as pipes, may still be readable
+        // in some other way.
+        unsupported(error.what());
+    }
+}
+}  // namespace
+
+ProblemData pyvrp::readInstance(std::string const &path,
+                                std::string const &instanceFormat,
+                                std::string const &roundFunc)
+{
+    auto const rounding = toRounding(roundFunc);
+
+    if (instanceFormat != "vrplib" && instanceFormat != "solomon")
+        unsupported("Unknown instance format " + instanceFormat + '.');
+
+    auto const file = openFile(path);
+    auto const lines = toLines({file->data(), file->size()});
+
+    auto const instance = instanceFormat == "vrplib" ? parseVrplib(lines)
+                                                     : parseSolomon(lines);
+
+    return toProblemData(instance, rounding);
+}
@@ -0,0 +1,67 @@
+#ifndef PYVRP_READ_INSTANCE_H
+#define PYVRP_READ_INSTANCE_H
+
+#include "ProblemData.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace pyvrp
+{
+/**
+ * Raised by :func:`~read_instance` for instance files that it does not
+ * support, because of their format or the data they contain. Such files may
+ * still be read by :func:`~pyvrp.read.read`, which then falls back to the
+ * ``vrplib`` package. This is a subclass of ``ValueError``.
+ */
+class UnsupportedInstanceError : public std::invalid_argument
+{
+public:
+    using std::invalid_argument::invalid_argument;
+};
+
+/**
+ * read_instance(
+ *     path: Union[str, os.PathLike],
+ *     instance_format: str = "vrplib",
+ *     round_func: str = "none",
+ * ) -> ProblemData
+ *
+ * Reads the instance file at the given path directly into a
+ * :class:`~ProblemData` instance, without going through the ``vrplib``
+ * package. Edge weights are computed and rounded on multiple threads for
+ * large instances. This function backs :func:`~pyvrp.read.read`, which
+ * should typically be used instead.
+ *
+ * Only part of the VRPLIB format is understood: the ``EUC_2D`` and
+ * ``EXPLICIT`` (in ``FULL_MATRIX`` format) edge weight types, and the node
+ * coordinate, demand, linehaul, backhaul, time window, service time, release
+ * time, prize, depot, and vehicles depot sections. The data is interpreted
+ * exactly as :func:`~pyvrp.read.read` does.
+ *
+ * Parameters
+ * ----------
+ * path
+ *     Path of the instance file to read.
+ * instance_format
+ *     File format of the instance, one of ``'vrplib'`` or ``'solomon'``.
+ * round_func
+ *     Name of the rounding function to apply. One of ``'round'``,
+ *     ``'trunc'``, ``'trunc1'``, ``'dimacs'``, or ``'none'``.
+ *
+ * Raises
+ * ------
+ * UnsupportedInstanceError
+ *     When the file cannot be opened, or contains data this reader does not
+ *     understand. This includes edge weights larger than
+ *     :const:`~pyvrp.constants.MAX_VALUE`, and, when PyVRP is compiled with
+ *     integer precision, data that is not integral and not rounded.
+ * ValueError
+ *     When the data is understood, but does not form a valid instance.
+ */
+ProblemData readInstance(std::string const &path,
+                         std::string const &instanceFormat = "vrplib",
+                         std::string const &roundFunc = "none");
+}  // namespace pyvrp
+
+#endif  // PYVRP_READ_INSTANCE_H
@@ -35,12 +35,15 @@ class Exchange : public LocalSearchOperator<Route::Node>
     // Tests if the segments of U and V are adjacent in the same route
     bool adjacent(Route::Node *U, Route::Node *V) const;
 
-    // Special case that's applied when M == 0
+    // Special case that's applied when M == 0. The timeWindows template
+    // argument determines whether time warp needs to be evaluated at all.
+    template <bool timeWindows>
     Cost evalRelocateMove(Route::Node *U,
                           Route::Node *V,
                           CostEvaluator const &costEvaluator) const;
 
     // Applied when M != 0
+    template <bool timeWindows>
     Cost evalSwapMove(Route::Node *U,
                       Route::Node *V,
                       CostEvaluator const &costEvaluator) const;
@@ -81,6 +84,7 @@ bool Exchange<N, M>::adjacent(Route::Node *U, Route::Node *V) const
 }
 
 template <size_t N, size_t M>
+template <bool timeWindows>
 Cost Exchange<N, M>::evalRelocateMove(Route::Node *U,
                                       Route::Node *V,
                                       CostEvaluator const &costEvaluator) const
@@ -92,6 +96,24 @@ Cost Exchange<N, M>::evalRelocateMove(Route::Node *U,
 
     Cost deltaCost = 0;
 
+    // Lower bound on the time warp penalty of the arcs this move creates. We
+    // use this to return early, before evaluating any duration segments.
+    Cost arcBound = 0;
+    if constexpr (timeWindows)
+    {
+        auto *endU = (*uRoute)[U->idx() + N - 1];
+        auto const uWarp = minTimeWarp(p(U), n(endU));
+        auto const vWarp = minTimeWarp(V, U) + minTimeWarp(endU, n(V));
+
+        // When V is in another route, its current time warp penalty is only
+        // subtracted after the early return checks below.
+        arcBound = uRoute == vRoute
+                       ? costEvaluator.twPenalty(uWarp + vWarp)
+                       : costEvaluator.twPenalty(uWarp)
+                             + costEvaluator.twPenalty(std::max<Duration>(
+                                 vWarp - vRoute->timeWarp(), 0));
+    }
+
     if (uRoute != vRoute)
     {
         auto const uDist = DistanceSegment::merge(data.distanceMatrix(),
@@ -117,17 +139,21 @@ Cost Exchange<N, M>::evalRelocateMove(Route::Node *U,
 
         deltaCost
             -= costEvaluator.loadPenalty(uRoute->load(), uRoute->capacity());
-        deltaCost -= costEvaluator.twPenalty(uRoute->timeWarp());
+        if constexpr (timeWindows)
+            deltaCost -= costEvaluator.twPenalty(uRoute->timeWarp());
 
-        if (deltaCost >= 0)
-            return deltaCost;
+        if (deltaCost + arcBound >= 0)
+            return deltaCost + arcBound;
 
-        auto uDS = DurationSegment::merge(data.durationMatrix(),
-                                          uRoute->before(U->idx() - 1),
-                                          uRoute->after(U->idx() + N));
+        if constexpr (timeWindows)
+        {
+            auto uDS = DurationSegment::merge(data.durationMatrix(),
+                                              uRoute->before(U->idx() - 1),
+                                              uRoute->after(U->idx() + N));
 
-        deltaCost
-            += costEvaluator.twPenalty(uDS.timeWarp(uRoute->maxDuration()));
+            deltaCost
+                += costEvaluator.twPenalty(uDS.timeWarp(uRoute->maxDuration()));
+        }
 
         auto const uLS = LoadSegment::merge(uRoute->before(U->idx() - 1),
                                             uRoute->after(U->idx() + N));
@@ -143,22 +169,26 @@ Cost Exchange<N, M>::evalRelocateMove(Route::Node *U,
         deltaCost
             -= costEvaluator.loadPenalty(vRoute->load(), vRoute->capacity());
 
-        auto const vDS = DurationSegment::merge(
-            data.durationMatrix(),
-            vRoute->before(V->idx()),
-            uRoute->between(U->idx(), U->idx() + N - 1),
-            vRoute->after(V->idx() + 1));
+        if constexpr (timeWindows)
+        {
+            auto const vDS = DurationSegment::merge(
+                data.durationMatrix(),
+                vRoute->before(V->idx()),
+                uRoute->between(U->idx(), U->idx() + N - 1),
+                vRoute->after(V->idx() + 1));
 
-        deltaCost
-            += costEvaluator.twPenalty(vDS.timeWarp(vRoute->maxDuration()));
-        deltaCost -= costEvaluator.twPenalty(vRoute->timeWarp());
+            deltaCost
+                += costEvaluator.twPenalty(vDS.timeWarp(vRoute->maxDuration()));
+            deltaCost -= costEvaluator.twPenalty(vRoute->timeWarp());
+        }
     }
     else  // within same route
     {
         deltaCost -= static_cast<Cost>(uRoute->distance());
         deltaCost
             -= costEvaluator.loadPenalty(uRoute->load(), uRoute->capacity());
-        deltaCost -= costEvaluator.twPenalty(uRoute->timeWarp());
+        if constexpr (timeWindows)
+            deltaCost -= costEvaluator.twPenalty(uRoute->timeWarp());
 
         if (U->idx() < V->idx())
         {
@@ -171,8 +201,8 @@ Cost Exchange<N, M>::evalRelocateMove(Route::Node *U,
 
             deltaCost += static_cast<Cost>(dist.distance());
 
-            if (deltaCost >= 0)
-                return deltaCost;
+            if (deltaCost + arcBound >= 0)
+                return deltaCost + arcBound;
 
             auto const ls = LoadSegment::merge(
                 uRoute->before(U->idx() - 1),
@@ -183,15 +213,18 @@ Cost Exchange<N, M>::evalRelocateMove(Route::Node *U,
             deltaCost
                 += costEvaluator.loadPenalty(ls.load(), uRoute->capacity());
 
-            auto const ds = DurationSegment::merge(
-                data.durationMatrix(),
-                uRoute->before(U->idx() - 1),
-                uRoute->between(U->idx() + N, V->idx()),
-                uRoute->between(U->idx(), U->idx() + N - 1),
-                uRoute->after(V->idx() + 1));
-
-            deltaCost
-                += costEvaluator.twPenalty(ds.timeWarp(uRoute->maxDuration()));
+            if constexpr (timeWindows)
+            {
+                auto const ds = DurationSegment::merge(
+                    data.durationMatrix(),
+                    uRoute->before(U->idx() - 1),
+                    uRoute->between(U->idx() + N, V->idx()),
+                    uRoute->between(U->idx(), U->idx() + N - 1),
+                    uRoute->after(V->idx() + 1));
+
+                deltaCost += costEvaluator.twPenalty(
+                    ds.timeWarp(uRoute->maxDuration()));
+            }
         }
         else
         {
@@ -204,8 +237,8 @@ Cost Exchange<N, M>::evalRelocateMove(Route::Node *U,
 
             deltaCost += static_cast<Cost>(dist.distance());
 
-            if (deltaCost >= 0)
-                return deltaCost;
+            if (deltaCost + arcBound >= 0)
+                return deltaCost + arcBound;
 
             auto const ls = LoadSegment::merge(
                 uRoute->before(V->idx()),
@@ -216,15 +249,18 @@ Cost Exchange<N, M>::evalRelocateMove(Route::Node *U,
             deltaCost
                 += costEvaluator.loadPenalty(ls.load(), uRoute->capacity());
 
-            auto const ds = DurationSegment::merge(
-                data.durationMatrix(),
-                uRoute->before(V->idx()),
-                uRoute->between(U->idx(), U->idx() + N - 1),
-                uRoute->between(V->idx() + 1, U->idx() - 1),
-                uRoute->after(U->idx() + N));
-
-            deltaCost
-                += costEvaluator.twPenalty(ds.timeWarp(uRoute->maxDuration()));
+            if constexpr (timeWindows)
+            {
+                auto const ds = DurationSegment::merge(
+                    data.durationMatrix(),
+                    uRoute->before(V->idx()),
+                    uRoute->between(U->idx(), U->idx() + N - 1),
+                    uRoute->between(V->idx() + 1, U->idx() - 1),
+                    uRoute->after(U->idx() + N));
+
+                deltaCost += costEvaluator.twPenalty(
+                    ds.timeWarp(uRoute->maxDuration()));
+            }
         }
     }
 
@@ -232,6 +268,7 @@ Cost Exchange<N, M>::evalRelocateMove(Route::Node *U,
 }
 
 template <size_t N, size_t M>
+template <bool timeWindows>
 Cost Exchange<N, M>::evalSwapMove(Route::Node *U,
                                   Route::Node *V,
                                   CostEvaluator const &costEvaluator) const
@@ -244,6 +281,19 @@ Cost Exchange<N, M>::evalSwapMove(Route::Node *U,
 
     Cost deltaCost = 0;
 
+    // Lower bound on the time warp penalty of the arcs this move creates. We
+    // use this to return early, before evaluating any duration segments.
+    Cost arcBound = 0;
+    if constexpr (timeWindows)
+    {
+        auto *endU = (*uRoute)[U->idx() + N - 1];
+        auto *endV = (*vRoute)[V->idx() + M - 1];
+        auto const warp = minTimeWarp(p(U), V) + minTimeWarp(endV, n(endU))
+                          + minTimeWarp(p(V), U) + minTimeWarp(endU, n(endV));
+
+        arcBound = costEvaluator.twPenalty(warp);
+    }
+
     if (uRoute != vRoute)
     {
         auto const uDist = DistanceSegment::merge(
@@ -264,25 +314,30 @@ Cost Exchange<N, M>::evalSwapMove(Route::Node *U,
         deltaCost += static_cast<Cost>(vDist.distance());
         deltaCost -= static_cast<Cost>(vRoute->distance());
 
-        deltaCost -= costEvaluator.twPenalty(uRoute->timeWarp());
+        if constexpr (timeWindows)
+            deltaCost -= costEvaluator.twPenalty(uRoute->timeWarp());
         deltaCost
             -= costEvaluator.loadPenalty(uRoute->load(), uRoute->capacity());
 
-        deltaCost -= costEvaluator.twPenalty(vRoute->timeWarp());
+        if constexpr (timeWindows)
+            deltaCost -= costEvaluator.twPenalty(vRoute->timeWarp());
         deltaCost
             -= costEvaluator.loadPenalty(vRoute->load(), vRoute->capacity());
 
-        if (deltaCost >= 0)
-            return deltaCost;
+        if (deltaCost + arcBound >= 0)
+            return deltaCost + arcBound;
 
-        auto const uDS = DurationSegment::merge(
-            data.durationMatrix(),
-            uRoute->before(U->idx() - 1),
-            vRoute->between(V->idx(), V->idx() + M - 1),
-            uRoute->after(U->idx() + N));
+        if constexpr (timeWindows)
+        {
+            auto const uDS = DurationSegment::merge(
+                data.durationMatrix(),
+                uRoute->before(U->idx() - 1),
+                vRoute->between(V->idx(), V->idx() + M - 1),
+                uRoute->after(U->idx() + N));
 
-        deltaCost
-            += costEvaluator.twPenalty(uDS.timeWarp(uRoute->maxDuration()));
+            deltaCost
+                += costEvaluator.twPenalty(uDS.timeWarp(uRoute->maxDuration()));
+        }
 
         auto const uLS
             = LoadSegment::merge(uRoute->before(U->idx() - 1),
@@ -291,14 +346,17 @@ Cost Exchange<N, M>::evalSwapMove(Route::Node *U,
 
         deltaCost += costEvaluator.loadPenalty(uLS.load(), uRoute->capacity());
 
-        auto const vDS = DurationSegment::merge(
-            data.durationMatrix(),
-            vRoute->before(V->idx() - 1),
-            uRoute->between(U->idx(), U->idx() + N - 1),
-            vRoute->after(V->idx() + M));
+        if constexpr (timeWindows)
+        {
+            auto const vDS = DurationSegment::merge(
+                data.durationMatrix(),
+                vRoute->before(V->idx() - 1),
+                uRoute->between(U->idx(), U->idx() + N - 1),
+                vRoute->after(V->idx() + M));
 
-        deltaCost
-            += costEvaluator.twPenalty(vDS.timeWarp(vRoute->maxDuration()));
+            deltaCost
+                += costEvaluator.twPenalty(vDS.timeWarp(vRoute->maxDuration()));
+        }
 
         auto const vLS
             = LoadSegment::merge(vRoute->before(V->idx() - 1),
@@ -312,7 +370,8 @@ Cost Exchange<N, M>::evalSwapMove(Route::Node *U,
         deltaCost -= static_cast<Cost>(uRoute->distance());
         deltaCost
             -= costEvaluator.loadPenalty(uRoute->load(), uRoute->capacity());
-        deltaCost -= costEvaluator.twPenalty(uRoute->timeWarp());
+        if constexpr (timeWindows)
+            deltaCost -= costEvaluator.twPenalty(uRoute->timeWarp());
 
         if (U->idx() < V->idx())
         {
@@ -326,8 +385,8 @@ Cost Exchange<N, M>::evalSwapMove(Route::Node *U,
 
             deltaCost += static_cast<Cost>(dist.distance());
 
-            if (deltaCost >= 0)
-                return deltaCost;
+            if (deltaCost + arcBound >= 0)
+                return deltaCost + arcBound;
 
             auto const ls = LoadSegment::merge(
                 uRoute->before(U->idx() - 1),
@@ -339,16 +398,19 @@ Cost Exchange<N, M>::evalSwapMove(Route::Node *U,
             deltaCost
                 += costEvaluator.loadPenalty(ls.load(), uRoute->capacity());
 
-            auto const ds = DurationSegment::merge(
-                data.durationMatrix(),
-                uRoute->before(U->idx() - 1),
-                uRoute->between(V->idx(), V->idx() + M - 1),
-                uRoute->between(U->idx() + N, V->idx() - 1),
-                uRoute->between(U->idx(), U->idx() + N - 1),
-                uRoute->after(V->idx() + M));
-
-            deltaCost
-                += costEvaluator.twPenalty(ds.timeWarp(uRoute->maxDuration()));
+            if constexpr (timeWindows)
+            {
+                auto const ds = DurationSegment::merge(
+                    data.durationMatrix(),
+                    uRoute->before(U->idx() - 1),
+                    uRoute->between(V->idx(), V->idx() + M - 1),
+                    uRoute->between(U->idx() + N, V->idx() - 1),
+                    uRoute->between(U->idx(), U->idx() + N - 1),
+                    uRoute->after(V->idx() + M));
+
+                deltaCost += costEvaluator.twPenalty(
+                    ds.timeWarp(uRoute->maxDuration()));
+            }
         }
         else
         {
@@ -362,8 +424,8 @@ Cost Exchange<N, M>::evalSwapMove(Route::Node *U,
 
             deltaCost += static_cast<Cost>(dist.distance());
 
-            if (deltaCost >= 0)
-                return deltaCost;
+            if (deltaCost + arcBound >= 0)
+                return deltaCost + arcBound;
 
             auto const ls = LoadSegment::merge(
                 uRoute->before(V->idx() - 1),
@@ -375,16 +437,19 @@ Cost Exchange<N, M>::evalSwapMove(Route::Node *U,
             deltaCost
                 += costEvaluator.loadPenalty(ls.load(), uRoute->capacity());
 
-            auto const ds = DurationSegment::merge(
-                data.durationMatrix(),
-                uRoute->before(V->idx() - 1),
-                uRoute->between(U->idx(), U->idx() + N - 1),
-                uRoute->between(V->idx() + M, U->idx() - 1),
-                uRoute->between(V->idx(), V->idx() + M - 1),
-                uRoute->after(U->idx() + N));
-
-            deltaCost
-                += costEvaluator.twPenalty(ds.timeWarp(uRoute->maxDuration()));
+            if constexpr (timeWindows)
+            {
+                auto const ds = DurationSegment::merge(
+                    data.durationMatrix(),
+                    uRoute->before(V->idx() - 1),
+                    uRoute->between(U->idx(), U->idx() + N - 1),
+                    uRoute->between(V->idx() + M, U->idx() - 1),
+                    uRoute->between(V->idx(), V->idx() + M - 1),
+                    uRoute->after(U->idx() + N));
+
+                deltaCost += costEvaluator.twPenalty(
+                    ds.timeWarp(uRoute->maxDuration()));
+            }
         }
     }
 
@@ -408,7 +473,10 @@ Cost Exchange<N, M>::evaluate(Route::Node *U,
         if (U == n(V))
             return 0;
 
-        return evalRelocateMove(U, V, costEvaluator);
+        if (data.hasTimeWindows())
+            return evalRelocateMove<true>(U, V, costEvaluator);
+
+        return evalRelocateMove<false>(U, V, costEvaluator);
     }
     else
     {
@@ -419,7 +487,10 @@ Cost Exchange<N, M>::evaluate(Route::Node *U,
         if (adjacent(U, V))
             return 0;
 
-        return evalSwapMove(U, V, costEvaluator);
+        if (data.hasTimeWindows())
+            return evalSwapMove<true>(U, V, costEvaluator);
+
+        return evalSwapMove<false>(U, V, costEvaluator);
     }
 }
 
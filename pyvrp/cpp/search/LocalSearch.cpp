@@ -70,8 +70,11 @@ void LocalSearch::search(CostEvaluator const &costEvaluator)
             lastTestedNodes[uClient] = numMoves;
 
             // First test removing or inserting U. Particularly relevant if not
-            // all clients are required (e.g., when prize collecting).
-            applyOptionalClientMoves(U, costEvaluator);
+            // all clients are required (e.g., when prize collecting). If all
+            // clients are required, we only need to insert U when it is not
+            // already in the solution.
+            if (data.hasOptionalClients() || !U->route())
+                applyOptionalClientMoves(U, costEvaluator);
 
             if (!U->route())  // we already evaluated inserting U, so there is
                 continue;     // nothing left to be done for this client.
@@ -371,7 +374,11 @@ Solution LocalSearch::exportSolution() const
     return {data, solRoutes};
 }
 
-void LocalSearch::addNodeOperator(NodeOp &op) { nodeOps.emplace_back(&op); }
+void LocalSearch::addNodeOperator(NodeOp &op)
+{
+    op.setTimeWindowArcs(timeWindowArcs);
+    nodeOps.emplace_back(&op);
+}
 
 void LocalSearch::addRouteOperator(RouteOp &op) { routeOps.emplace_back(&op); }
 
@@ -415,6 +422,11 @@ LocalSearch::LocalSearch(ProblemData const &data, Neighbours neighbours)
 {
     setNeighbours(neighbours);
 
+#ifndef PYVRP_NO_TIME_WINDOWS
+    if (data.hasTimeWindows())
+        timeWindowArcs = std::make_shared<TimeWindowArcs const>(data);
+#endif
+
     std::iota(orderNodes.begin(), orderNodes.end(), data.numDepots());
     std::iota(orderRoutes.begin(), orderRoutes.end(), 0);
 
@@ -7,8 +7,10 @@
 #include "RandomNumberGenerator.h"
 #include "Route.h"
 #include "Solution.h"
+#include "TimeWindowArcs.h"
 
 #include <functional>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
@@ -34,6 +36,10 @@ class LocalSearch
     std::vector<Route::Node> nodes;
     std::vector<Route> routes;
 
+    // Time-infeasible arcs, shared with the node operators. Only computed
+    // when the instance has time windows.
+    std::shared_ptr<TimeWindowArcs const> timeWindowArcs;
+
     std::vector<NodeOp *> nodeOps;
     std::vector<RouteOp *> routeOps;
 
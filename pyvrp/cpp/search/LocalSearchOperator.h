@@ -6,6 +6,9 @@
 #include "ProblemData.h"
 #include "Route.h"
 #include "Solution.h"
+#include "TimeWindowArcs.h"
+
+#include <memory>
 
 namespace pyvrp::search
 {
@@ -55,6 +58,33 @@ class LocalSearchOperator<Route::Node>
     : public LocalSearchOperatorBase<Route::Node>
 {
     using LocalSearchOperatorBase::LocalSearchOperatorBase;
+
+    // Time-infeasible arcs, if provided by the local search. This may be
+    // empty, e.g. when the instance does not have time windows.
+    std::shared_ptr<TimeWindowArcs const> timeWindowArcs;
+
+protected:
+    /**
+     * Returns a lower bound on the time warp incurred by any route containing
+     * the arc between the given nodes. This bound is zero if no time window
+     * arc information is available.
+     */
+    Duration minTimeWarp(Route::Node const *from, Route::Node const *to) const
+    {
+        return timeWindowArcs
+                   ? timeWindowArcs->minTimeWarp(from->client(), to->client())
+                   : Duration(0);
+    }
+
+public:
+    /**
+     * Sets the time window arcs this operator can use to reject moves that
+     * introduce time-infeasible arcs, without evaluating them in full.
+     */
+    void setTimeWindowArcs(std::shared_ptr<TimeWindowArcs const> arcs)
+    {
+        timeWindowArcs = std::move(arcs);
+    }
 };
 
 template <>  // specialisation for route operators
@@ -1,19 +1,39 @@
 #include "MoveTwoClientsReversed.h"
 #include "Route.h"
 
+#include <algorithm>
+
 using pyvrp::search::MoveTwoClientsReversed;
 
-pyvrp::Cost MoveTwoClientsReversed::evaluate(
-    Route::Node *U, Route::Node *V, pyvrp::CostEvaluator const &costEvaluator)
+template <bool timeWindows>
+pyvrp::Cost MoveTwoClientsReversed::evalMove(
+    Route::Node *U,
+    Route::Node *V,
+    pyvrp::CostEvaluator const &costEvaluator) const
 {
-    if (U == n(V) || n(U) == V || n(U)->isDepot())
-        return 0;
-
     auto *uRoute = U->route();
     auto *vRoute = V->route();
 
     Cost deltaCost = 0;
 
+    // Lower bound on the time warp penalty of the arcs this move creates. We
+    // use this to return early, before evaluating any duration segments.
+    Cost arcBound = 0;
+    if constexpr (timeWindows)
+    {
+        auto *X = n(U);
+        auto const uWarp = minTimeWarp(p(U), n(X));
+        auto const vWarp = minTimeWarp(V, X) + minTimeWarp(U, n(V));
+
+        // When V is in another route, its current time warp penalty is only
+        // subtracted after the early return checks below.
+        arcBound = uRoute == vRoute
+                       ? costEvaluator.twPenalty(uWarp + vWarp)
+                       : costEvaluator.twPenalty(uWarp)
+                             + costEvaluator.twPenalty(std::max<Duration>(
+                                 vWarp - vRoute->timeWarp(), 0));
+    }
+
     if (uRoute != vRoute)
     {
         auto const uDist = DistanceSegment::merge(data.distanceMatrix(),
@@ -37,19 +57,23 @@ pyvrp::Cost MoveTwoClientsReversed::evaluate(
         deltaCost += Cost(vRoute->empty()) * vRoute->fixedVehicleCost();
         deltaCost -= Cost(uRoute->size() == 2) * uRoute->fixedVehicleCost();
 
-        deltaCost -= costEvaluator.twPenalty(uRoute->timeWarp());
+        if constexpr (timeWindows)
+            deltaCost -= costEvaluator.twPenalty(uRoute->timeWarp());
         deltaCost
             -= costEvaluator.loadPenalty(uRoute->load(), uRoute->capacity());
 
-        if (deltaCost >= 0)
-            return deltaCost;
+        if (deltaCost + arcBound >= 0)
+            return deltaCost + arcBound;
 
-        auto uDS = DurationSegment::merge(data.durationMatrix(),
-                                          uRoute->before(U->idx() - 1),
-                                          uRoute->after(U->idx() + 2));
+        if constexpr (timeWindows)
+        {
+            auto uDS = DurationSegment::merge(data.durationMatrix(),
+                                              uRoute->before(U->idx() - 1),
+                                              uRoute->after(U->idx() + 2));
 
-        deltaCost
-            += costEvaluator.twPenalty(uDS.timeWarp(uRoute->maxDuration()));
+            deltaCost
+                += costEvaluator.twPenalty(uDS.timeWarp(uRoute->maxDuration()));
+        }
 
         auto const uLS = LoadSegment::merge(uRoute->before(U->idx() - 1),
                                             uRoute->after(U->idx() + 2));
@@ -65,22 +89,26 @@ pyvrp::Cost MoveTwoClientsReversed::evaluate(
         deltaCost
             -= costEvaluator.loadPenalty(vRoute->load(), vRoute->capacity());
 
-        auto vDS = DurationSegment::merge(data.durationMatrix(),
-                                          vRoute->before(V->idx()),
-                                          uRoute->at(U->idx() + 1),
-                                          uRoute->at(U->idx()),
-                                          vRoute->after(V->idx() + 1));
+        if constexpr (timeWindows)
+        {
+            auto vDS = DurationSegment::merge(data.durationMatrix(),
+                                              vRoute->before(V->idx()),
+                                              uRoute->at(U->idx() + 1),
+                                              uRoute->at(U->idx()),
+                                              vRoute->after(V->idx() + 1));
 
-        deltaCost
-            += costEvaluator.twPenalty(vDS.timeWarp(vRoute->maxDuration()));
-        deltaCost -= costEvaluator.twPenalty(vRoute->timeWarp());
+            deltaCost
+                += costEvaluator.twPenalty(vDS.timeWarp(vRoute->maxDuration()));
+            deltaCost -= costEvaluator.twPenalty(vRoute->timeWarp());
+        }
     }
     else  // within same route
     {
         deltaCost -= static_cast<Cost>(uRoute->distance());
         deltaCost
             -= costEvaluator.loadPenalty(uRoute->load(), uRoute->capacity());
-        deltaCost -= costEvaluator.twPenalty(uRoute->timeWarp());
+        if constexpr (timeWindows)
+            deltaCost -= costEvaluator.twPenalty(uRoute->timeWarp());
 
         if (U->idx() < V->idx())
         {
@@ -94,8 +122,8 @@ pyvrp::Cost MoveTwoClientsReversed::evaluate(
 
             deltaCost += static_cast<Cost>(dist.distance());
 
-            if (deltaCost >= 0)
-                return deltaCost;
+            if (deltaCost + arcBound >= 0)
+                return deltaCost + arcBound;
 
             auto const ls
                 = LoadSegment::merge(uRoute->before(U->idx() - 1),
@@ -107,16 +135,19 @@ pyvrp::Cost MoveTwoClientsReversed::evaluate(
             deltaCost
                 += costEvaluator.loadPenalty(ls.load(), uRoute->capacity());
 
-            auto const ds = DurationSegment::merge(
-                data.durationMatrix(),
-                uRoute->before(U->idx() - 1),
-                uRoute->between(U->idx() + 2, V->idx()),
-                uRoute->at(U->idx() + 1),
-                uRoute->at(U->idx()),
-                uRoute->after(V->idx() + 1));
-
-            deltaCost
-                += costEvaluator.twPenalty(ds.timeWarp(uRoute->maxDuration()));
+            if constexpr (timeWindows)
+            {
+                auto const ds = DurationSegment::merge(
+                    data.durationMatrix(),
+                    uRoute->before(U->idx() - 1),
+                    uRoute->between(U->idx() + 2, V->idx()),
+                    uRoute->at(U->idx() + 1),
+                    uRoute->at(U->idx()),
+                    uRoute->after(V->idx() + 1));
+
+                deltaCost += costEvaluator.twPenalty(
+                    ds.timeWarp(uRoute->maxDuration()));
+            }
         }
         else
         {
@@ -130,8 +161,8 @@ pyvrp::Cost MoveTwoClientsReversed::evaluate(
 
             deltaCost += static_cast<Cost>(dist.distance());
 
-            if (deltaCost >= 0)
-                return deltaCost;
+            if (deltaCost + arcBound >= 0)
+                return deltaCost + arcBound;
 
             auto const ls = LoadSegment::merge(
                 uRoute->before(V->idx()),
@@ -143,22 +174,37 @@ pyvrp::Cost MoveTwoClientsReversed::evaluate(
             deltaCost
                 += costEvaluator.loadPenalty(ls.load(), uRoute->capacity());
 
-            auto const ds = DurationSegment::merge(
-                data.durationMatrix(),
-                uRoute->before(V->idx()),
-                uRoute->at(U->idx() + 1),
-                uRoute->at(U->idx()),
-                uRoute->between(V->idx() + 1, U->idx() - 1),
-                uRoute->after(U->idx() + 2));
-
-            deltaCost
-                += costEvaluator.twPenalty(ds.timeWarp(uRoute->maxDuration()));
+            if constexpr (timeWindows)
+            {
+                auto const ds = DurationSegment::merge(
+                    data.durationMatrix(),
+                    uRoute->before(V->idx()),
+                    uRoute->at(U->idx() + 1),
+                    uRoute->at(U->idx()),
+                    uRoute->between(V->idx() + 1, U->idx() - 1),
+                    uRoute->after(U->idx() + 2));
+
+                deltaCost += costEvaluator.twPenalty(
+                    ds.timeWarp(uRoute->maxDuration()));
+            }
         }
     }
 
     return deltaCost;
 }
 
+pyvrp::Cost MoveTwoClientsReversed::evaluate(
+    Route::Node *U, Route::Node *V, pyvrp::CostEvaluator const &costEvaluator)
+{
+    if (U == n(V) || n(U) == V || n(U)->isDepot())
+        return 0;
+
+    if (data.hasTimeWindows())
+        return evalMove<true>(U, V, costEvaluator);
+
+    return evalMove<false>(U, V, costEvaluator);
+}
+
 void MoveTwoClientsReversed::apply(Route::Node *U, Route::Node *V) const
 {
     auto *X = n(U);  // copy since the insert below changes n(U)
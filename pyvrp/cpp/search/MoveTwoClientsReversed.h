@@ -16,6 +16,13 @@ class MoveTwoClientsReversed : public LocalSearchOperator<Route::Node>
 {
     using LocalSearchOperator::LocalSearchOperator;
 
+    // Evaluates the move. The timeWindows template argument determines
+    // whether time warp needs to be evaluated at all.
+    template <bool timeWindows>
+    Cost evalMove(Route::Node *U,
+                  Route::Node *V,
+                  CostEvaluator const &costEvaluator) const;
+
 public:
     Cost evaluate(Route::Node *U,
                   Route::Node *V,
@@ -130,15 +130,13 @@ void Route::insert(size_t idx, Node *node)
     distBefore.emplace(distBefore.begin() + idx, node->client());
     distAfter.emplace(distAfter.begin() + idx, node->client());
 
-    ProblemData::Client const &client = data.location(node->client());
+    loadAt.emplace(loadAt.begin() + idx, data, node->client());
+    loadAfter.emplace(loadAfter.begin() + idx, data, node->client());
+    loadBefore.emplace(loadBefore.begin() + idx, data, node->client());
 
-    loadAt.emplace(loadAt.begin() + idx, client);
-    loadAfter.emplace(loadAfter.begin() + idx, client);
-    loadBefore.emplace(loadBefore.begin() + idx, client);
-
-    durAt.emplace(durAt.begin() + idx, node->client(), client);
-    durAfter.emplace(durAfter.begin() + idx, node->client(), client);
-    durBefore.emplace(durBefore.begin() + idx, node->client(), client);
+    durAt.emplace(durAt.begin() + idx, data, node->client());
+    durAfter.emplace(durAfter.begin() + idx, data, node->client());
+    durBefore.emplace(durBefore.begin() + idx, data, node->client());
 
 #ifndef NDEBUG
     dirty = true;
@@ -215,6 +213,7 @@ void Route::update()
 {
     centroid_ = {0, 0};
 
+    auto const &attrs = data.attributes();
     for (size_t idx = 1; idx != nodes.size(); ++idx)
     {
         auto const *node = nodes[idx];
@@ -222,9 +221,8 @@ void Route::update()
 
         if (!node->isDepot())
         {
-            ProblemData::Client const &clientData = data.location(client);
-            centroid_.first += static_cast<double>(clientData.x) / size();
-            centroid_.second += static_cast<double>(clientData.y) / size();
+            centroid_.first += static_cast<double>(attrs.x[client]) / size();
+            centroid_.second += static_cast<double>(attrs.y[client]) / size();
         }
     }
 
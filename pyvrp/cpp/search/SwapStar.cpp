@@ -226,10 +226,11 @@ Cost SwapStar::evaluate(Route *routeU,
             // Approximates the actual load changes - this is far from exact
             // when there are also pickups. So it's pretty rough, but fast and
             // seems to work well enough for most instances.
-            ProblemData::Client const &uClient = data.location(U->client());
-            ProblemData::Client const &vClient = data.location(V->client());
-            auto const uLoad = std::max(uClient.delivery, uClient.pickup);
-            auto const vLoad = std::max(vClient.delivery, vClient.pickup);
+            auto const &attrs = data.attributes();
+            auto const uLoad = std::max(attrs.delivery[U->client()],
+                                        attrs.pickup[U->client()]);
+            auto const vLoad = std::max(attrs.delivery[V->client()],
+                                        attrs.pickup[V->client()]);
             auto const loadDiff = uLoad - vLoad;
 
             deltaCost += costEvaluator.loadPenalty(routeU->load() - loadDiff,
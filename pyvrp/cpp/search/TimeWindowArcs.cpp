@@ -0,0 +1,8 @@
+#include "TimeWindowArcs.h"
+
+using pyvrp::search::TimeWindowArcs;
+
+TimeWindowArcs::TimeWindowArcs(ProblemData const &data)
+    : data(data), attrs(data.attributes())
+{
+}
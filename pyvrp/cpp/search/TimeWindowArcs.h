@@ -0,0 +1,55 @@
+#ifndef PYVRP_TIMEWINDOWARCS_H
+#define PYVRP_TIMEWINDOWARCS_H
+
+#include "Measure.h"
+#include "ProblemData.h"
+
+namespace pyvrp::search
+{
+/**
+ * Time-infeasible arcs. An arc (i, j) is time-infeasible if, even when service
+ * at i starts as early as possible, a vehicle cannot reach j after service and
+ * travel before j's time window closes. Any route that contains such an arc
+ * incurs at least some time warp at j. Local search operators use this to
+ * reject moves creating such arcs before evaluating any duration segments.
+ *
+ * The time warp of an arc is computed when it is needed, from the time windows
+ * and service durations in the problem data's location attributes, and its
+ * duration matrix. Nothing is precomputed, so this costs no memory or setup
+ * time, also for very large instances.
+ */
+class TimeWindowArcs
+{
+    ProblemData const &data;
+    ProblemData::LocationAttributes const &attrs;
+
+public:
+    /**
+     * Returns a lower bound on the time warp incurred at ``to`` by any route
+     * containing the arc (from, to): the time warp at ``to`` when travelling
+     * directly from ``from`` while starting service there as early as
+     * possible. This is zero when the arc is time-feasible.
+     */
+    [[nodiscard]] inline Duration minTimeWarp(size_t from, size_t to) const;
+
+    explicit TimeWindowArcs(ProblemData const &data);
+};
+
+Duration TimeWindowArcs::minTimeWarp(size_t from, size_t to) const
+{
+    if (from == to)
+        return 0;
+
+    // Service at from cannot start before its time window opens, so we arrive
+    // at to no earlier than the following. Any arrival after to's time window
+    // closes results in time warp. We compare rather than subtract first to
+    // avoid overflowing when the time window is unconstrained.
+    auto const arrival = attrs.twEarly[from] + attrs.serviceDuration[from]
+                         + data.durationMatrix()(from, to);
+
+    auto const twLate = attrs.twLate[to];
+    return arrival > twLate ? arrival - twLate : Duration(0);
+}
+}  // namespace pyvrp::search
+
+#endif  // PYVRP_TIMEWINDOWARCS_H
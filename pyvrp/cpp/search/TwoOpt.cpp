@@ -7,6 +7,7 @@
 using pyvrp::Cost;
 using pyvrp::search::TwoOpt;
 
+template <bool timeWindows>
 Cost TwoOpt::evalWithinRoute(Route::Node *U,
                              Route::Node *V,
                              CostEvaluator const &costEvaluator) const
@@ -16,8 +17,18 @@ Cost TwoOpt::evalWithinRoute(Route::Node *U,
 
     Cost deltaCost
         = -static_cast<Cost>(route->distance())
-          - costEvaluator.loadPenalty(route->load(), route->capacity())
-          - costEvaluator.twPenalty(route->timeWarp());
+          - costEvaluator.loadPenalty(route->load(), route->capacity());
+
+    // Lower bound on the time warp penalty of the arcs this move creates. We
+    // use this to return early, before evaluating any duration segments.
+    Cost arcBound = 0;
+    if constexpr (timeWindows)
+    {
+        deltaCost -= costEvaluator.twPenalty(route->timeWarp());
+
+        auto const warp = minTimeWarp(U, V) + minTimeWarp(n(U), n(V));
+        arcBound = costEvaluator.twPenalty(warp);
+    }
 
     // Current situation is U -> n(U) -> ... -> V -> n(V). Proposed move is
     // U -> V -> p(V) -> ... -> n(U) -> n(V). This reverses the segment from
@@ -31,8 +42,8 @@ Cost TwoOpt::evalWithinRoute(Route::Node *U,
 
     deltaCost += static_cast<Cost>(dist.distance());
 
-    if (deltaCost >= 0)
-        return deltaCost;
+    if (deltaCost + arcBound >= 0)
+        return deltaCost + arcBound;
 
     LoadSegment ls = route->before(U->idx());
     for (size_t idx = V->idx(); idx != U->idx(); --idx)
@@ -41,17 +52,23 @@ Cost TwoOpt::evalWithinRoute(Route::Node *U,
 
     deltaCost += costEvaluator.loadPenalty(ls.load(), route->capacity());
 
-    DurationSegment ds = route->before(U->idx());
-    for (size_t idx = V->idx(); idx != U->idx(); --idx)
-        ds = DurationSegment::merge(data.durationMatrix(), ds, route->at(idx));
-    ds = DurationSegment::merge(
-        data.durationMatrix(), ds, route->after(V->idx() + 1));
+    if constexpr (timeWindows)
+    {
+        DurationSegment ds = route->before(U->idx());
+        for (size_t idx = V->idx(); idx != U->idx(); --idx)
+            ds = DurationSegment::merge(
+                data.durationMatrix(), ds, route->at(idx));
+        ds = DurationSegment::merge(
+            data.durationMatrix(), ds, route->after(V->idx() + 1));
 
-    deltaCost += costEvaluator.twPenalty(ds.timeWarp(route->maxDuration()));
+        deltaCost
+            += costEvaluator.twPenalty(ds.timeWarp(route->maxDuration()));
+    }
 
     return deltaCost;
 }
 
+template <bool timeWindows>
 Cost TwoOpt::evalBetweenRoutes(Route::Node *U,
                                Route::Node *V,
                                CostEvaluator const &costEvaluator) const
@@ -119,55 +136,76 @@ Cost TwoOpt::evalBetweenRoutes(Route::Node *U,
     deltaCost -= static_cast<Cost>(uRoute->distance());
     deltaCost -= static_cast<Cost>(vRoute->distance());
 
-    deltaCost -= costEvaluator.twPenalty(uRoute->timeWarp());
-    deltaCost -= costEvaluator.twPenalty(vRoute->timeWarp());
-
-    deltaCost -= costEvaluator.loadPenalty(uRoute->load(), uRoute->capacity());
-    deltaCost -= costEvaluator.loadPenalty(vRoute->load(), vRoute->capacity());
-
-    if (deltaCost >= 0)
-        return deltaCost;
-
-    if (V->idx() < vRoute->size())
+    // Lower bound on the time warp penalty of the arcs this move creates. We
+    // use this to return early, before evaluating any duration segments. If
+    // the move ends a route directly after U or V, that route's own end depot
+    // is the new successor.
+    Cost arcBound = 0;
+    if constexpr (timeWindows)
     {
-        auto const uDS = DurationSegment::merge(
-            data.durationMatrix(),
-            uRoute->before(U->idx()),
-            vRoute->between(V->idx() + 1, vRoute->size()),
-            uRoute->at(uRoute->size() + 1));
+        deltaCost -= costEvaluator.twPenalty(uRoute->timeWarp());
+        deltaCost -= costEvaluator.twPenalty(vRoute->timeWarp());
 
-        deltaCost
-            += costEvaluator.twPenalty(uDS.timeWarp(uRoute->maxDuration()));
-    }
-    else
-    {
-        auto const uDS = DurationSegment::merge(data.durationMatrix(),
-                                                uRoute->before(U->idx()),
-                                                uRoute->at(uRoute->size() + 1));
+        auto *uEnd = (*U->route())[uRoute->size() + 1];
+        auto *vEnd = (*V->route())[vRoute->size() + 1];
 
-        deltaCost
-            += costEvaluator.twPenalty(uDS.timeWarp(uRoute->maxDuration()));
+        auto *uNext = n(V)->isDepot() ? uEnd : n(V);
+        auto *vNext = n(U)->isDepot() ? vEnd : n(U);
+        auto const warp = minTimeWarp(U, uNext) + minTimeWarp(V, vNext);
+        arcBound = costEvaluator.twPenalty(warp);
     }
 
-    if (U->idx() < uRoute->size())
-    {
-        auto const vDS = DurationSegment::merge(
-            data.durationMatrix(),
-            vRoute->before(V->idx()),
-            uRoute->between(U->idx() + 1, uRoute->size()),
-            vRoute->at(vRoute->size() + 1));
+    deltaCost -= costEvaluator.loadPenalty(uRoute->load(), uRoute->capacity());
+    deltaCost -= costEvaluator.loadPenalty(vRoute->load(), vRoute->capacity());
 
-        deltaCost
-            += costEvaluator.twPenalty(vDS.timeWarp(vRoute->maxDuration()));
-    }
-    else
-    {
-        auto const vDS = DurationSegment::merge(data.durationMatrix(),
-                                                vRoute->before(V->idx()),
-                                                vRoute->at(vRoute->size() + 1));
+    if (deltaCost + arcBound >= 0)
+        return deltaCost + arcBound;
 
-        deltaCost
-            += costEvaluator.twPenalty(vDS.timeWarp(vRoute->maxDuration()));
+    if constexpr (timeWindows)
+    {
+        if (V->idx() < vRoute->size())
+        {
+            auto const uDS = DurationSegment::merge(
+                data.durationMatrix(),
+                uRoute->before(U->idx()),
+                vRoute->between(V->idx() + 1, vRoute->size()),
+                uRoute->at(uRoute->size() + 1));
+
+            deltaCost
+                += costEvaluator.twPenalty(uDS.timeWarp(uRoute->maxDuration()));
+        }
+        else
+        {
+            auto const uDS
+                = DurationSegment::merge(data.durationMatrix(),
+                                         uRoute->before(U->idx()),
+                                         uRoute->at(uRoute->size() + 1));
+
+            deltaCost
+                += costEvaluator.twPenalty(uDS.timeWarp(uRoute->maxDuration()));
+        }
+
+        if (U->idx() < uRoute->size())
+        {
+            auto const vDS = DurationSegment::merge(
+                data.durationMatrix(),
+                vRoute->before(V->idx()),
+                uRoute->between(U->idx() + 1, uRoute->size()),
+                vRoute->at(vRoute->size() + 1));
+
+            deltaCost
+                += costEvaluator.twPenalty(vDS.timeWarp(vRoute->maxDuration()));
+        }
+        else
+        {
+            auto const vDS
+                = DurationSegment::merge(data.durationMatrix(),
+                                         vRoute->before(V->idx()),
+                                         vRoute->at(vRoute->size() + 1));
+
+            deltaCost
+                += costEvaluator.twPenalty(vDS.timeWarp(vRoute->maxDuration()));
+        }
     }
 
     auto const uLS = LoadSegment::merge(uRoute->before(U->idx()),
@@ -231,12 +269,20 @@ Cost TwoOpt::evaluate(Route::Node *U,
         return 0;
 
     if (U->route() != V->route())
-        return evalBetweenRoutes(U, V, costEvaluator);
+    {
+        if (data.hasTimeWindows())
+            return evalBetweenRoutes<true>(U, V, costEvaluator);
+
+        return evalBetweenRoutes<false>(U, V, costEvaluator);
+    }
 
     if (U->idx() + 1 >= V->idx())  // tackled in a later iteration
         return 0;
 
-    return evalWithinRoute(U, V, costEvaluator);
+    if (data.hasTimeWindows())
+        return evalWithinRoute<true>(U, V, costEvaluator);
+
+    return evalWithinRoute<false>(U, V, costEvaluator);
 }
 
 void TwoOpt::apply(Route::Node *U, Route::Node *V) const
@@ -22,10 +22,14 @@ class TwoOpt : public LocalSearchOperator<Route::Node>
 {
     using LocalSearchOperator::LocalSearchOperator;
 
+    // The timeWindows template argument of the evaluation methods below
+    // determines whether time warp needs to be evaluated at all.
+    template <bool timeWindows>
     Cost evalWithinRoute(Route::Node *U,
                          Route::Node *V,
                          CostEvaluator const &costEvaluator) const;
 
+    template <bool timeWindows>
     Cost evalBetweenRoutes(Route::Node *U,
                            Route::Node *V,
                            CostEvaluator const &costEvaluator) const;
@@ -7,6 +7,7 @@
 #include "SwapRoutes.h"
 #include "SwapStar.h"
 #include "TwoOpt.h"
+#include "neighbourhood.h"
 #include "primitives.h"
 #include "search_docs.h"
 
@@ -18,6 +19,7 @@
 namespace py = pybind11;
 
 using pyvrp::search::Exchange;
+using pyvrp::search::computeNeighbours;
 using pyvrp::search::insertCost;
 using pyvrp::search::LocalSearch;
 using pyvrp::search::LocalSearchOperator;
@@ -387,6 +389,16 @@ PYBIND11_MODULE(_search, m)
         .def_property_readonly("route", &Route::Node::route)
         .def("is_depot", &Route::Node::isDepot);
 
+    m.def("compute_neighbours",
+          &computeNeighbours,
+          py::arg("data"),
+          py::arg("weight_wait_time"),
+          py::arg("weight_time_warp"),
+          py::arg("num_neighbours"),
+          py::arg("symmetric_proximity"),
+          py::arg("symmetric_neighbours"),
+          DOC(pyvrp, search, computeNeighbours));
+
     m.def("insert_cost",
           &insertCost,
           py::arg("U"),
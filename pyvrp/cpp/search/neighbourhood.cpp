@@ -0,0 +1,119 @@
+#include "neighbourhood.h"
+
+#include <algorithm>
+#include <utility>
+
+using pyvrp::ProblemData;
+
+namespace
+{
+// Proximity of visiting client j directly after client i. This is computed in
+// floating point, so that unconstrained time windows do not overflow.
+class Proximity
+{
+    ProblemData const &data;
+    ProblemData::LocationAttributes const &attrs;
+    double const weightWaitTime;
+    double const weightTimeWarp;
+
+public:
+    Proximity(ProblemData const &data,
+              double weightWaitTime,
+              double weightTimeWarp)
+        : data(data),
+          attrs(data.attributes()),
+          weightWaitTime(weightWaitTime),
+          weightTimeWarp(weightTimeWarp)
+    {
+    }
+
+    double operator()(size_t i, size_t j) const
+    {
+        auto const dist = static_cast<double>(data.dist(i, j));
+        auto const dur = static_cast<double>(data.duration(i, j));
+        auto const service = static_cast<double>(attrs.serviceDuration[i]);
+
+        auto const earlyI = static_cast<double>(attrs.twEarly[i]);
+        auto const lateI = static_cast<double>(attrs.twLate[i]);
+        auto const earlyJ = static_cast<double>(attrs.twEarly[j]);
+        auto const lateJ = static_cast<double>(attrs.twLate[j]);
+
+        // Minimum wait time and time warp of visiting j directly after i.
+        auto const minWait = earlyJ - dur - service - lateI;
+        auto const minTimeWarp = earlyI + service + dur - lateJ;
+
+        return dist + weightWaitTime * std::max(minWait, 0.0)
+               + weightTimeWarp * std::max(minTimeWarp, 0.0)
+               - static_cast<double>(attrs.prize[j]);
+    }
+};
+}  // namespace
+
+std::vector<std::vector<size_t>>
+pyvrp::search::computeNeighbours(ProblemData const &data,
+                                 double weightWaitTime,
+                                 double weightTimeWarp,
+                                 size_t numNeighbours,
+                                 bool symmetricProximity,
+                                 bool symmetricNeighbours)
+{
+    auto const numDepots = data.numDepots();
+    auto const numLocs = data.numLocations();
+    auto const numClients = data.numClients();
+    auto const k = std::min(numNeighbours, numClients ? numClients - 1 : 0);
+
+    Proximity const proximity(data, weightWaitTime, weightTimeWarp);
+    std::vector<std::vector<size_t>> neighbours(numLocs);
+
+    // Proximity and index of the other clients. Pairs compare by proximity
+    // first, so sorting these breaks ties between equally close clients by
+    // their index.
+    std::vector<std::pair<double, size_t>> others;
+    others.reserve(numClients);
+
+    for (size_t client = numDepots; client != numLocs; ++client)
+    {
+        others.clear();
+        for (size_t other = numDepots; other != numLocs; ++other)
+        {
+            if (other == client)  // cannot be in own neighbourhood
+                continue;
+
+            auto prox = proximity(client, other);
+            if (symmetricProximity)
+                prox = std::min(prox, proximity(other, client));
+
+            others.emplace_back(prox, other);
+        }
+
+        std::partial_sort(others.begin(), others.begin() + k, others.end());
+
+        auto &clientNeighbours = neighbours[client];
+        clientNeighbours.reserve(k);
+        for (size_t idx = 0; idx != k; ++idx)
+            clientNeighbours.push_back(others[idx].second);
+    }
+
+    if (!symmetricNeighbours)
+        return neighbours;
+
+    // When (i, j) is in the neighbourhood, then so is (j, i). The symmetrised
+    // neighbourhoods list their neighbours by index.
+    std::vector<std::vector<size_t>> symmetric(numLocs);
+    for (size_t client = numDepots; client != numLocs; ++client)
+        for (auto const other : neighbours[client])
+        {
+            symmetric[client].push_back(other);
+            symmetric[other].push_back(client);
+        }
+
+    for (auto &clientNeighbours : symmetric)
+    {
+        std::sort(clientNeighbours.begin(), clientNeighbours.end());
+        auto const last
+            = std::unique(clientNeighbours.begin(), clientNeighbours.end());
+        clientNeighbours.erase(last, clientNeighbours.end());
+    }
+
+    return symmetric;
+}
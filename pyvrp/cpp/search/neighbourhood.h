@@ -0,0 +1,51 @@
+#ifndef PYVRP_SEARCH_NEIGHBOURHOOD_H
+#define PYVRP_SEARCH_NEIGHBOURHOOD_H
+
+#include "ProblemData.h"
+
+#include <vector>
+
+namespace pyvrp::search
+{
+/**
+ * Computes the granular neighbourhood of each client, as described in
+ * :func:`~pyvrp.search.neighbourhood.compute_neighbours`. The proximity of
+ * client :math:`j` to client :math:`i` is the distance from :math:`i` to
+ * :math:`j`, plus the weighted minimum wait time and time warp of visiting
+ * :math:`j` directly after :math:`i`, less the prize of :math:`j`. Distances
+ * and durations are looked up one pair at a time, so the full matrices are
+ * never unpacked.
+ *
+ * Parameters
+ * ----------
+ * data
+ *     Problem data instance.
+ * weight_wait_time
+ *     Weight given to the minimum wait time aspect of the proximity.
+ * weight_time_warp
+ *     Weight given to the minimum time warp aspect of the proximity.
+ * num_neighbours
+ *     Number of other clients in each client's neighbourhood.
+ * symmetric_proximity
+ *     Whether edge :math:`(i, j)` is given the same proximity as
+ *     :math:`(j, i)`: the smallest of the two.
+ * symmetric_neighbours
+ *     Whether :math:`(j, i)` is added to the neighbourhood when
+ *     :math:`(i, j)` is in it.
+ *
+ * Returns
+ * -------
+ * list
+ *     The neighbours of each location. Depots have no neighbours. Clients
+ *     list their neighbours closest first, with ties broken by index, or by
+ *     index only when the neighbourhood is symmetrised.
+ */
+std::vector<std::vector<size_t>> computeNeighbours(ProblemData const &data,
+                                                   double weightWaitTime,
+                                                   double weightTimeWarp,
+                                                   size_t numNeighbours,
+                                                   bool symmetricProximity,
+                                                   bool symmetricNeighbours);
+}  // namespace pyvrp::search
+
+#endif  // PYVRP_SEARCH_NEIGHBOURHOOD_H
@@ -9,10 +9,10 @@ pyvrp::Cost pyvrp::search::insertCost(Route::Node *U,
         return 0;
 
     auto *route = V->route();
-    ProblemData::Client const &client = data.location(U->client());
+    auto const &attrs = data.attributes();
 
-    Cost deltaCost
-        = Cost(route->empty()) * route->fixedVehicleCost() - client.prize;
+    Cost deltaCost = Cost(route->empty()) * route->fixedVehicleCost()
+                     - attrs.prize[U->client()];
 
     auto const distSegment
         = DistanceSegment::merge(data.distanceMatrix(),
@@ -24,7 +24,7 @@ pyvrp::Cost pyvrp::search::insertCost(Route::Node *U,
     deltaCost -= static_cast<Cost>(route->distance());
 
     auto const ls = LoadSegment::merge(route->before(V->idx()),
-                                       LoadSegment(client),
+                                       LoadSegment(data, U->client()),
                                        route->after(V->idx() + 1));
 
     deltaCost += costEvaluator.loadPenalty(ls.load(), route->capacity());
@@ -32,7 +32,7 @@ pyvrp::Cost pyvrp::search::insertCost(Route::Node *U,
 
     auto const ds = DurationSegment::merge(data.durationMatrix(),
                                            route->before(V->idx()),
-                                           DurationSegment(U->client(), client),
+                                           DurationSegment(data, U->client()),
                                            route->after(V->idx() + 1));
 
     deltaCost += costEvaluator.twPenalty(ds.timeWarp(route->maxDuration()));
@@ -49,10 +49,10 @@ pyvrp::Cost pyvrp::search::removeCost(Route::Node *U,
         return 0;
 
     auto *route = U->route();
-    ProblemData::Client const &client = data.location(U->client());
+    auto const &attrs = data.attributes();
 
-    Cost deltaCost
-        = client.prize - Cost(route->size() == 1) * route->fixedVehicleCost();
+    Cost deltaCost = attrs.prize[U->client()]
+                     - Cost(route->size() == 1) * route->fixedVehicleCost();
 
     auto const distSegment = DistanceSegment::merge(data.distanceMatrix(),
                                                     route->before(U->idx() - 1),
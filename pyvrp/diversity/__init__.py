@@ -1 +1,4 @@
+from ._diversity import (
+    approximate_broken_pairs_distance as approximate_broken_pairs_distance,
+)
 from ._diversity import broken_pairs_distance as broken_pairs_distance
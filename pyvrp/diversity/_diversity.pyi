@@ -1,3 +1,6 @@
 from pyvrp._pyvrp import Solution
 
 def broken_pairs_distance(first: Solution, second: Solution) -> float: ...
+def approximate_broken_pairs_distance(
+    first: Solution, second: Solution
+) -> float: ...
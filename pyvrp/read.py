@@ -7,7 +7,14 @@ from warnings import warn
 import numpy as np
 import vrplib
 
-from pyvrp._pyvrp import Client, Depot, ProblemData, VehicleType
+from pyvrp._pyvrp import (
+    Client,
+    Depot,
+    ProblemData,
+    UnsupportedInstanceError,
+    VehicleType,
+    read_instance,
+)
 from pyvrp.constants import MAX_VALUE
 from pyvrp.exceptions import ScalingWarning
 
@@ -50,7 +57,9 @@ def read(
 ) -> ProblemData:
     """
     Reads the VRPLIB file at the given location, and returns a ProblemData
-    instance.
+    instance. When ``round_func`` names a rounding function, the file is read
+    by the faster :func:`~pyvrp._pyvrp.read_instance` if it supports the
+    file's contents.
 
     .. note::
 
@@ -90,7 +99,15 @@ def read(
         Data instance constructed from the read data.
     """
     if (key := str(round_func)) in ROUND_FUNCS:
-        round_func = ROUND_FUNCS[key]
+        try:
+            # Most instances can be read directly by the native reader, which
+            # is much faster than going through the vrplib package. It raises
+            # a dedicated error for anything it does not support, and then we
+            # fall back to the regular path below. Other errors mean the
+            # instance itself is invalid, so those are raised as-is.
+            return read_instance(where, instance_format, key)
+        except UnsupportedInstanceError:
+            round_func = ROUND_FUNCS[key]
 
     if not callable(round_func):
         raise TypeError(
@@ -118,6 +118,14 @@ class Node:
     def route(self) -> Optional[Route]: ...
     def is_depot(self) -> bool: ...
 
+def compute_neighbours(
+    data: ProblemData,
+    weight_wait_time: float,
+    weight_time_warp: float,
+    num_neighbours: int,
+    symmetric_proximity: bool,
+    symmetric_neighbours: bool,
+) -> list[list[int]]: ...
 def insert_cost(
     U: Node, V: Node, data: ProblemData, cost_evaluator: CostEvaluator
 ) -> int: ...
@@ -3,7 +3,7 @@ from __future__ import annotations
 from dataclasses import dataclass
 from typing import TYPE_CHECKING
 
-import numpy as np
+from pyvrp.search._search import compute_neighbours as _compute_neighbours
 
 if TYPE_CHECKING:
     from pyvrp import ProblemData
@@ -58,6 +58,10 @@ def compute_neighbours(
 ) -> list[list[int]]:
     """
     Computes neighbours defining the neighbourhood for a problem instance.
+    Proximity is based on [1]_, with modification for additional VRP
+    variants. The distance and duration matrices are not unpacked for this,
+    so that large instances can compute their neighbourhood without the
+    memory cost of the full matrices.
 
     Parameters
     ----------
@@ -71,57 +75,6 @@ def compute_neighbours(
     list
         A list of list of integers representing the neighbours for each client.
         The first element represents the depot and is an empty list.
-    """
-    proximity = _compute_proximity(
-        data,
-        params.weight_wait_time,
-        params.weight_time_warp,
-    )
-
-    if params.symmetric_proximity:
-        proximity = np.minimum(proximity, proximity.T)
-
-    n = len(proximity)
-    k = min(params.nb_granular, data.num_clients - 1)  # excl. self
-
-    np.fill_diagonal(proximity, np.inf)  # cannot be in own neighbourhood
-    proximity[: data.num_depots, :] = np.inf  # depots have no neighbours
-    proximity[:, : data.num_depots] = np.inf  # clients do not neighbour depots
-
-    top_k = np.argsort(proximity, axis=1, kind="stable")[data.num_depots :, :k]
-
-    if not params.symmetric_neighbours:
-        return [[] for _ in range(data.num_depots)] + top_k.tolist()
-
-    # Construct a symmetric adjacency matrix and return the adjacent clients
-    # as the neighbourhood structure.
-    adj = np.zeros_like(proximity, dtype=bool)
-    rows = np.expand_dims(np.arange(data.num_depots, n), axis=1)
-    adj[rows, top_k] = True
-    adj = adj | adj.transpose()
-
-    return [np.flatnonzero(row).tolist() for row in adj]
-
-
-def _compute_proximity(
-    data: ProblemData, weight_wait_time: float, weight_time_warp: float
-) -> np.ndarray[float]:
-    """
-    Computes proximity for neighborhood. Proximity is based on [1]_, with
-    modification for additional VRP variants.
-
-    Parameters
-    ----------
-    data
-        ProblemData for which to compute proximity.
-    params
-        NeighbourhoodParams that define how proximity is computed.
-
-    Returns
-    -------
-    np.ndarray[float]
-        An array of size :py:attr:`~pyvrp._pyvrp.ProblemData.num_locations`
-        by :py:attr:`~pyvrp._pyvrp.ProblemData.num_locations`.
 
     References
     ----------
@@ -130,26 +83,11 @@ def _compute_proximity(
            large class of vehicle routing problems with time-windows.
            *Computers & Operations Research*, 40(1), 475 - 489.
     """
-    clients = [data.location(loc) for loc in range(data.num_locations)]
-
-    early = np.asarray([c.tw_early for c in clients])
-    late = np.asarray([c.tw_late for c in clients])
-
-    service = np.zeros_like(early)
-    service[data.num_depots :] = [c.service_duration for c in data.clients()]
-
-    prize = np.zeros_like(early)
-    prize[data.num_depots :] = [client.prize for client in data.clients()]
-
-    duration = data.duration_matrix()
-
-    # Minimum wait time and time warp of visiting j directly after i.
-    min_wait = early[None, :] - duration - service[:, None] - late[:, None]
-    min_tw = early[:, None] + service[:, None] + duration - late[None, :]
-
-    return (
-        np.asarray(data.distance_matrix(), dtype=float)
-        + weight_wait_time * np.maximum(min_wait, 0)
-        + weight_time_warp * np.maximum(min_tw, 0)
-        - prize[None, :]
+    return _compute_neighbours(
+        data,
+        params.weight_wait_time,
+        params.weight_time_warp,
+        params.nb_granular,
+        params.symmetric_proximity,
+        params.symmetric_neighbours,
     )
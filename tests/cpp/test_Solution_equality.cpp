@@ -0,0 +1,108 @@
+// Tests that comparing solutions does not allocate any memory. This cannot be
+// observed from Python, so this test replaces the global allocation functions
+// with ones that count the number of allocations made.
+
+#include "Matrix.h"
+#include "Measure.h"
+#include "ProblemData.h"
+#include "Solution.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using pyvrp::Distance;
+using pyvrp::Duration;
+using pyvrp::Matrix;
+using pyvrp::ProblemData;
+using pyvrp::Solution;
+
+namespace
+{
+size_t numAllocations = 0;
+}  // namespace
+
+void *operator new(size_t size)
+{
+    ++numAllocations;
+    if (void *ptr = std::malloc(size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+
+namespace
+{
+ProblemData makeData()
+{
+    // One depot and six clients on a line, and two vehicle types that only
+    // differ in their capacity.
+    size_t const numLocs = 7;
+
+    std::vector<ProblemData::Depot> depots = {{0, 0}};
+    std::vector<ProblemData::Client> clients;
+    for (size_t client = 1; client != numLocs; ++client)
+        clients.emplace_back(client, 0, 1);
+
+    Matrix<Distance> distances(numLocs, numLocs);
+    Matrix<Duration> durations(numLocs, numLocs);
+    for (size_t row = 0; row != numLocs; ++row)
+        for (size_t col = 0; col != numLocs; ++col)
+        {
+            auto const dist = row > col ? row - col : col - row;
+            distances(row, col) = dist;
+            durations(row, col) = dist;
+        }
+
+    std::vector<ProblemData::VehicleType> vehicleTypes = {{2, 10}, {2, 20}};
+    return {clients, depots, vehicleTypes, distances, durations};
+}
+
+// Returns whether the given solutions compare as expected, without
+// allocating. Prints a message explaining the failure otherwise.
+bool check(char const *what,
+           Solution const &first,
+           Solution const &second,
+           bool expected)
+{
+    auto const before = numAllocations;
+    auto const equal = first == second;
+    auto const allocations = numAllocations - before;
+
+    if (equal != expected)
+        std::printf("%s: expected %d, got %d.\n", what, expected, equal);
+
+    if (allocations != 0)
+        std::printf("%s: %zu allocations.\n", what, allocations);
+
+    return equal == expected && allocations == 0;
+}
+}  // namespace
+
+int main()
+{
+    auto const data = makeData();
+
+    auto const route = [&](std::vector<size_t> visits, size_t type = 0) {
+        return Solution::Route(data, visits, type);
+    };
+
+    Solution const sol(data, {route({1, 2, 3}), route({4, 5})});
+    Solution const copy(sol);
+    Solution const reordered(data, {route({4, 5}), route({1, 2, 3})});
+    Solution const otherVisits(data, {route({1, 2}), route({3, 4, 5})});
+    Solution const otherType(data, {route({1, 2, 3}, 1), route({4, 5})});
+
+    bool passed = true;
+    passed &= check("copy", sol, copy, true);
+    passed &= check("reordered routes", sol, reordered, true);
+    passed &= check("other visits", sol, otherVisits, false);
+    passed &= check("other vehicle type", sol, otherType, false);
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
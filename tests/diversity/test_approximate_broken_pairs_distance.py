@@ -0,0 +1,62 @@
+import numpy as np
+from numpy.testing import assert_, assert_allclose
+
+from pyvrp import RandomNumberGenerator, Solution
+from pyvrp.diversity import approximate_broken_pairs_distance as approx_bpd
+from pyvrp.diversity import broken_pairs_distance as bpd
+
+
+def test_same_solution_is_zero(rc208):
+    """
+    Approximate broken pairs distance of a solution with itself should be zero.
+    """
+    rng = RandomNumberGenerator(seed=1)
+    sol = Solution.make_random(rc208, rng)
+    assert_allclose(approx_bpd(sol, sol), 0.0)
+
+
+def test_exact_for_small_instances(ok_small):
+    """
+    When the sketches contain all pairs, and both solutions visit the same
+    clients, the approximation should be exact.
+    """
+    rng = RandomNumberGenerator(seed=2)
+    sols = [Solution.make_random(ok_small, rng) for _ in range(10)]
+
+    for first in sols:
+        for second in sols:
+            assert_allclose(approx_bpd(first, second), bpd(first, second))
+
+
+def test_ranking_agrees_with_broken_pairs_distance(rc208):
+    """
+    Validates that the approximation ranks solutions by distance (nearly) the
+    same as the exact broken pairs distance does. We construct solutions that
+    are increasingly different from a base solution, and compare the rank
+    correlation of their distances to the base solution.
+    """
+    rng = RandomNumberGenerator(seed=3)
+    base = Solution.make_random(rc208, rng)
+    base_routes = [route.visits() for route in base.get_routes()]
+
+    exact = []
+    approx = []
+    for num_swaps in range(50):
+        routes = [visits.copy() for visits in base_routes]
+        for _ in range(num_swaps):  # swap two random clients
+            first = routes[rng.randint(len(routes))]
+            second = routes[rng.randint(len(routes))]
+            idx1 = rng.randint(len(first))
+            idx2 = rng.randint(len(second))
+            first[idx1], second[idx2] = second[idx2], first[idx1]
+
+        sol = Solution(rc208, routes)
+        exact.append(bpd(base, sol))
+        approx.append(approx_bpd(base, sol))
+
+    # Spearman's rank correlation between the exact and approximate distances
+    # should be high. Additionally, the approximation error should be small.
+    exact_ranks = np.argsort(np.argsort(exact))
+    approx_ranks = np.argsort(np.argsort(approx))
+    assert_(np.corrcoef(exact_ranks, approx_ranks)[0, 1] > 0.9)
+    assert_allclose(approx, exact, atol=0.15)
@@ -1,7 +1,7 @@
 import pytest
 from numpy.testing import assert_allclose
 
-from pyvrp import Solution
+from pyvrp import RandomNumberGenerator, Solution
 from pyvrp.diversity import broken_pairs_distance as bpd
 
 
@@ -39,3 +39,32 @@ def test_bpd_calculations_on_examples(ok_small, routes, expected):
     # Test that BPD is as expected, and that it is symmetric.
     assert_allclose(bpd(reference, alternative), expected)
     assert_allclose(bpd(alternative, reference), expected)
+
+
+def test_bpd_matches_neighbours_on_larger_instance(prize_collecting):
+    """
+    Tests that the broken pairs distance agrees with a direct computation based
+    on the solutions' neighbours, also for solutions with unassigned clients
+    and an instance that is larger than a single vector register.
+    """
+    rng = RandomNumberGenerator(seed=42)
+    sols = [Solution.make_random(prize_collecting, rng) for _ in range(5)]
+
+    # Also add some solutions that do not visit all (optional) clients.
+    for sol in sols[:3]:
+        routes = [route.visits()[::2] for route in sol.get_routes()]
+        sols.append(Solution(prize_collecting, routes))
+
+    for first in sols:
+        for second in sols:
+            f_neighbours = first.get_neighbours()
+            s_neighbours = second.get_neighbours()
+
+            num_broken = 0
+            for f_nb, s_nb in zip(f_neighbours, s_neighbours):
+                f_pred, f_succ = f_nb if f_nb is not None else (None, None)
+                s_pred, s_succ = s_nb if s_nb is not None else (None, None)
+                num_broken += (f_pred != s_pred) + (f_succ != s_succ)
+
+            expected = num_broken / (2 * prize_collecting.num_locations)
+            assert_allclose(bpd(first, second), expected)
@@ -424,3 +424,42 @@ def test_within_route_simultaneous_pickup_and_delivery(operator):
     # before 1.
     cost_eval = CostEvaluator(1, 1)
     assert_allclose(op.evaluate(route[1], route[3], cost_eval), -5)
+
+
+@pytest.mark.parametrize("operator", [Exchange10, Exchange11, Exchange21])
+def test_time_window_arcs_do_not_change_improving_moves(rc208, operator):
+    """
+    Operators added to a local search object may use that object's information
+    about time-infeasible arcs to return early. This should never change the
+    evaluation of improving moves.
+    """
+    rng = RandomNumberGenerator(seed=42)
+    sol = Solution.make_random(rc208, rng)
+
+    routes = []
+    for idx, sol_route in enumerate(sol.get_routes()):
+        route = Route(rc208, idx=idx, vehicle_type=sol_route.vehicle_type())
+        for client in sol_route:
+            route.append(Node(loc=client))
+        route.update()
+        routes.append(route)
+
+    plain_op = operator(rc208)
+    ls_op = operator(rc208)
+    ls = LocalSearch(rc208, rng, compute_neighbours(rc208))
+    ls.add_node_operator(ls_op)
+
+    nodes = [node for route in routes for node in route]
+    cost_eval = CostEvaluator(20, 100)
+    for U in nodes:
+        for V in nodes:
+            if U == V:
+                continue
+
+            plain_delta = plain_op.evaluate(U, V, cost_eval)
+            ls_delta = ls_op.evaluate(U, V, cost_eval)
+
+            if plain_delta < 0 or ls_delta < 0:
+                assert_equal(ls_delta, plain_delta)
+            else:
+                assert_(ls_delta >= 0)
@@ -16,9 +16,11 @@ from pyvrp.search import (
     Exchange10,
     Exchange11,
     LocalSearch,
+    MoveTwoClientsReversed,
     NeighbourhoodParams,
     RelocateStar,
     SwapStar,
+    TwoOpt,
     compute_neighbours,
 )
 from pyvrp.search._search import LocalSearch as cpp_LocalSearch
@@ -452,3 +454,44 @@ def test_local_search_does_not_remove_required_clients():
     sol_cost = cost_eval.penalised_cost(sol)
     new_cost = cost_eval.penalised_cost(new_sol)
     assert_(new_cost < sol_cost)
+
+
+def test_search_same_with_and_without_time_window_evaluation(small_cvrp):
+    """
+    Instances without time windows are evaluated by specialised routines that
+    skip all time warp calculations. Adding a maximum route duration that can
+    never be binding enables these calculations again, but that should not
+    change the search result.
+    """
+    veh_type = small_cvrp.vehicle_type(0)
+    data_tw = small_cvrp.replace(
+        vehicle_types=[
+            VehicleType(
+                veh_type.num_available,
+                capacity=veh_type.capacity,
+                max_duration=1_000_000_000,
+            )
+        ]
+    )
+
+    assert_(not small_cvrp.has_time_windows)
+    assert_(data_tw.has_time_windows)
+
+    cost_eval = CostEvaluator(20, 6)
+    solutions = []
+    for data in (small_cvrp, data_tw):
+        rng = RandomNumberGenerator(seed=42)
+        ls = LocalSearch(data, rng, compute_neighbours(data))
+        ls.add_node_operator(Exchange10(data))
+        ls.add_node_operator(Exchange11(data))
+        ls.add_node_operator(MoveTwoClientsReversed(data))
+        ls.add_node_operator(TwoOpt(data))
+
+        sol = Solution.make_random(data, rng)
+        solutions.append(ls(sol, cost_eval))
+
+    sol, sol_tw = solutions
+    routes = [route.visits() for route in sol.get_routes()]
+    routes_tw = [route.visits() for route in sol_tw.get_routes()]
+    assert_equal(routes, routes_tw)
+    assert_equal(sol.distance(), sol_tw.distance())
@@ -146,3 +146,48 @@ def test_within_route_simultaneous_pickup_and_delivery():
     # any excess load.
     cost_eval = CostEvaluator(1, 1)
     assert_allclose(op.evaluate(route[1], route[3], cost_eval), -5)
+
+
+def test_time_window_arcs_do_not_change_improving_moves(rc208):
+    """
+    MoveTwoClientsReversed may use a local search object's information about
+    time-infeasible arcs to return early. This should never change the
+    evaluation of improving moves, and pruned moves should never appear to
+    improve.
+    """
+    rng = RandomNumberGenerator(seed=42)
+    sol = Solution.make_random(rc208, rng)
+
+    routes = []
+    for idx, sol_route in enumerate(sol.get_routes()):
+        route = Route(rc208, idx=idx, vehicle_type=sol_route.vehicle_type())
+        for client in sol_route:
+            route.append(Node(loc=client))
+        route.update()
+        routes.append(route)
+
+    plain_op = MoveTwoClientsReversed(rc208)
+    ls_op = MoveTwoClientsReversed(rc208)
+    ls = LocalSearch(rc208, rng, compute_neighbours(rc208))
+    ls.add_node_operator(ls_op)
+
+    num_improving = 0
+    nodes = [node for route in routes for node in route]
+    cost_eval = CostEvaluator(20, 100)
+    for U in nodes:
+        for V in nodes:
+            if U == V:
+                continue
+
+            plain_delta = plain_op.evaluate(U, V, cost_eval)
+            ls_delta = ls_op.evaluate(U, V, cost_eval)
+
+            if plain_delta < 0 or ls_delta < 0:
+                assert_equal(ls_delta, plain_delta)
+                num_improving += 1
+            else:
+                assert_(ls_delta >= 0)
+
+    # A random solution leaves lots to improve, so the operator should still
+    # find improving moves.
+    assert_(num_improving > 0)
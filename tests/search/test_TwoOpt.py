@@ -266,3 +266,47 @@ def test_move_involving_multiple_depots():
     # First would be 0 -> 0, second 1 -> 2 -> 3 -> 1. Distance on route1 would
     # be zero, and on route2 16. Thus delta cost is -16.
     assert_allclose(op.evaluate(route1[0], route2[1], cost_eval), -16)
+
+
+def test_time_window_arcs_do_not_change_improving_moves(rc208):
+    """
+    TwoOpt may use a local search object's information about time-infeasible
+    arcs to return early. This should never change the evaluation of
+    improving moves, and pruned moves should never appear to improve.
+    """
+    rng = RandomNumberGenerator(seed=42)
+    sol = Solution.make_random(rc208, rng)
+
+    routes = []
+    for idx, sol_route in enumerate(sol.get_routes()):
+        route = Route(rc208, idx=idx, vehicle_type=sol_route.vehicle_type())
+        for client in sol_route:
+            route.append(Node(loc=client))
+        route.update()
+        routes.append(route)
+
+    plain_op = TwoOpt(rc208)
+    ls_op = TwoOpt(rc208)
+    ls = LocalSearch(rc208, rng, compute_neighbours(rc208))
+    ls.add_node_operator(ls_op)
+
+    num_improving = 0
+    nodes = [node for route in routes for node in route]
+    cost_eval = CostEvaluator(20, 100)
+    for U in nodes:
+        for V in nodes:
+            if U == V:
+                continue
+
+            plain_delta = plain_op.evaluate(U, V, cost_eval)
+            ls_delta = ls_op.evaluate(U, V, cost_eval)
+
+            if plain_delta < 0 or ls_delta < 0:
+                assert_equal(ls_delta, plain_delta)
+                num_improving += 1
+            else:
+                assert_(ls_delta >= 0)
+
+    # A random solution leaves lots to improve, so the operator should still
+    # find improving moves.
+    assert_(num_improving > 0)
@@ -2,6 +2,7 @@ import numpy as np
 from numpy.testing import assert_, assert_equal, assert_raises
 from pytest import mark
 
+from pyvrp import Metric, ProblemData
 from pyvrp.search import NeighbourhoodParams, compute_neighbours
 
 
@@ -200,3 +201,33 @@ def test_proximity_with_prizes(prize_collecting):
     count_20 = sum(20 in n for n in neighbours)
     count_36 = sum(36 in n for n in neighbours)
     assert_(count_20 > count_36)
+
+
+def test_compute_neighbours_does_not_unpack_metric_matrices(
+    rc208, monkeypatch
+):
+    """
+    Tests that the neighbourhood of an instance whose matrices are computed
+    by a metric is computed without unpacking the full distance or duration
+    matrix, and that no such dense copy is kept afterwards.
+    """
+    data = rc208.replace(distance_matrix=Metric(), duration_matrix=Metric())
+    unpacked = data.replace(
+        distance_matrix=data.distance_matrix(),
+        duration_matrix=data.duration_matrix(),
+    )
+    expected = compute_neighbours(unpacked)
+
+    def fail(*args, **kwargs):
+        raise AssertionError("The full matrix should not be unpacked.")
+
+    with monkeypatch.context() as patch:
+        patch.setattr(ProblemData, "distance_matrix", fail)
+        patch.setattr(ProblemData, "duration_matrix", fail)
+        assert_equal(compute_neighbours(data), expected)
+
+    # Full matrices that are requested explicitly are temporary arrays, which
+    # the instance does not keep either.
+    dist1, dist2 = data.distance_matrix(), data.distance_matrix()
+    assert_equal(dist1, dist2)
+    assert_(not np.shares_memory(dist1, dist2))
@@ -106,7 +106,7 @@ def test_params_constructor_does_not_raise_when_arguments_valid(
     assert_equal(params.max_pop_size, min_pop_size + generation_size)
 
 
-def test_add_triggers_purge(ok_small):
+def test_add_triggers_purge(rc208):
     """
     Tests that adding another solution to a population of maximum size triggers
     survivor selection, that is, a purge that reduces the relevant population
@@ -118,39 +118,39 @@ def test_add_triggers_purge(ok_small):
     params = PopulationParams()
     pop = Population(bpd, params=params)
     for _ in range(params.min_pop_size):
-        pop.add(Solution.make_random(ok_small, rng), cost_evaluator)
+        pop.add(Solution.make_random(rc208, rng), cost_evaluator)
 
-    # Population should initialise at least min_pop_size solutions
-    assert_(len(pop) >= params.min_pop_size)
-    assert_equal(len(pop), pop.num_feasible() + pop.num_infeasible())
+    # Population should initialise at least min_pop_size solutions. Random
+    # solutions to RC208 are all different, and all infeasible.
+    assert_equal(len(pop), params.min_pop_size)
+    assert_equal(pop.num_infeasible(), params.min_pop_size)
 
-    num_feas = pop.num_feasible()
     num_infeas = pop.num_infeasible()
 
-    while True:  # keep adding feasible solutions until we are about to purge
-        sol = Solution.make_random(ok_small, rng)
+    while True:  # keep adding infeasible solutions until we are about to purge
+        sol = Solution.make_random(rc208, rng)
 
-        if sol.is_feasible():
+        if not sol.is_feasible():
             pop.add(sol, cost_evaluator)
-            num_feas += 1
+            num_infeas += 1
 
-            assert_equal(len(pop), num_feas + num_infeas)
-            assert_equal(pop.num_feasible(), num_feas)
+            assert_equal(len(pop), num_infeas)
+            assert_equal(pop.num_infeasible(), num_infeas)
 
-        if num_feas == params.max_pop_size:  # next add() triggers purge
+        if num_infeas == params.max_pop_size:  # next add() triggers purge
             break
 
-    # RNG is fixed, and this next solution is feasible. Since we now have a
-    # feasible population that is of maximal size, adding this solution should
-    # trigger survivor selection (purge). Survivor selection reduces the
-    # feasible subpopulation to min_pop_size, so the overal population is then
-    # just num_infeas + min_pop_size.
-    sol = Solution.make_random(ok_small, rng)
-    assert_(sol.is_feasible())
+    # RNG is fixed, and this next solution is infeasible. Since we now have an
+    # infeasible population that is of maximal size, adding this solution
+    # should trigger survivor selection (purge). Survivor selection reduces the
+    # infeasible subpopulation to min_pop_size, so that is then the size of
+    # the overall population.
+    sol = Solution.make_random(rc208, rng)
+    assert_(not sol.is_feasible())
 
     pop.add(sol, cost_evaluator)
-    assert_equal(pop.num_feasible(), params.min_pop_size)
-    assert_equal(len(pop), num_infeas + params.min_pop_size)
+    assert_equal(pop.num_infeasible(), params.min_pop_size)
+    assert_equal(len(pop), params.min_pop_size)
 
 
 def test_select_returns_same_parents_if_no_other_option(ok_small):
@@ -320,10 +320,10 @@ def test_tournament_raises_for_invalid_k(rc208, k: int):
         pop.get_tournament(rng, cost_evaluator, k=k)
 
 
-def test_purge_removes_duplicates(rc208):
+def test_add_skips_duplicates(rc208):
     """
-    Tests that purging/survivor selection first removes duplicate solutions,
-    before purging by (biased) fitness.
+    Tests that adding a solution that is equal to one already in the
+    population does not change the population.
     """
     cost_evaluator = CostEvaluator(20, 6)
     params = PopulationParams(min_pop_size=20, generation_size=5)
@@ -335,32 +335,23 @@ def test_purge_removes_duplicates(rc208):
 
     assert_equal(len(pop), params.min_pop_size)
 
-    # This is the solution we are going to add a few times. That should make
-    # sure the relevant subpopulation definitely contains duplicates.
+    # This is the solution we are going to add a few times. Only the first
+    # time should add it to the population; the others are duplicates.
     sol = Solution.make_random(rc208, rng)
     assert_(not sol.is_feasible())
 
     for _ in range(params.generation_size):
         pop.add(sol, cost_evaluator)
 
-    # Make sure we have not yet purged, and increase the minimum population
-    # size by one to make sure we're definitely not removing *all* of the
-    # duplicate solutions.
-    assert_(pop.num_infeasible() != params.min_pop_size)
-    params.min_pop_size += 1
-
-    # Keep adding the solution until we have had a purge, and returned to the
-    # minimum population size. Note that the purge is done after adding the
-    # solution, so we must add the same solution in order to have at most
-    # min_pop_size - 1 other solutions than the duplicated solution.
-    while pop.num_infeasible() != params.min_pop_size:
-        pop.add(sol, cost_evaluator)
+    assert_equal(len(pop), params.min_pop_size + 1)
 
-    # Since duplicates are purged first, there should now be only one of them
-    # in the subpopulation. There cannot be zero, because we made sure of that.
     duplicates = sum(other == sol for other in pop)
     assert_equal(duplicates, 1)
 
+    # The same holds for an equal solution that is a different object.
+    pop.add(Solution(rc208, sol.routes()), cost_evaluator)
+    assert_equal(len(pop), params.min_pop_size + 1)
+
 
 def test_clear(rc208):
     """
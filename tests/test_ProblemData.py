@@ -1,9 +1,20 @@
+import pickle
+
 import numpy as np
 import pytest
 from numpy.random import default_rng
 from numpy.testing import assert_, assert_allclose, assert_equal, assert_raises
 
-from pyvrp import Client, Depot, ProblemData, VehicleType
+from pyvrp import (
+    Client,
+    Depot,
+    Metric,
+    ProblemData,
+    VehicleType,
+    read_instance_file,
+    write_instance_file,
+    write_matrix,
+)
 
 
 @pytest.mark.parametrize(
@@ -223,7 +234,7 @@ def test_problem_data_raises_matrix_diagonal_nonzero(dist_mat, dur_mat):
 def test_problem_data_replace_no_changes():
     """
     Tests that when using ``ProblemData.replace()`` without any arguments
-    returns a new instance with different objects, but with the same values.
+    returns a new instance with the same values.
     """
     clients = [Client(x=0, y=0)]
     depots = [Depot(x=0, y=0)]
@@ -236,7 +247,6 @@ def test_problem_data_replace_no_changes():
     assert_(new is not original)
 
     for idx in range(new.num_clients):
-        assert_(new.location(idx) is not original.location(idx))
         assert_equal(new.location(idx).x, original.location(idx).x)
         assert_equal(new.location(idx).y, original.location(idx).y)
 
@@ -244,7 +254,6 @@ def test_problem_data_replace_no_changes():
         new_veh_type = new.vehicle_type(idx)
         og_veh_type = original.vehicle_type(idx)
 
-        assert_(new_veh_type is not og_veh_type)
         assert_equal(new_veh_type.capacity, og_veh_type.capacity)
         assert_equal(new_veh_type.num_available, og_veh_type.num_available)
 
@@ -258,6 +267,38 @@ def test_problem_data_replace_no_changes():
     assert_equal(new.num_vehicle_types, original.num_vehicle_types)
 
 
+def test_problem_data_replace_shares_unchanged_data():
+    """
+    Tests that ``ProblemData.replace()`` shares the data that is not replaced
+    with the original instance, rather than copying it.
+    """
+    mat = np.array([[0, 2**40], [1, 0]])  # stored as-is, so can be viewed
+    original = ProblemData(
+        clients=[Client(x=0, y=0)],
+        depots=[Depot(x=0, y=0)],
+        vehicle_types=[VehicleType(2, capacity=1)],
+        distance_matrix=mat,
+        duration_matrix=mat,
+    )
+
+    new = original.replace(vehicle_types=[VehicleType(3, capacity=2)])
+    assert_equal(new.num_vehicles, 3)
+    assert_equal(original.num_vehicles, 2)
+
+    new_dist, orig_dist = new.distance_matrix(), original.distance_matrix()
+    assert_(np.shares_memory(new_dist, orig_dist))
+
+    new_dur, orig_dur = new.duration_matrix(), original.duration_matrix()
+    assert_(np.shares_memory(new_dur, orig_dur))
+
+    # Replaced data is still validated.
+    with assert_raises(ValueError):
+        original.replace(distance_matrix=np.eye(2, dtype=int))
+
+    with assert_raises(ValueError):
+        original.replace(clients=[Client(x=0, y=0), Client(x=1, y=1)])
+
+
 def test_problem_data_replace_with_changes():
     """
     Tests that when calling ``ProblemData.replace()`` indeed replaces the
@@ -407,7 +448,7 @@ def test_matrices_are_not_copies():
     offer views into data owned by the underlying ``ProblemData`` instance.
     There is no copying going on when accessing this data.
     """
-    mat = np.array([[0, 0], [0, 0]])
+    mat = np.array([[0, 2**40], [1, 0]])  # not symmetric, nor narrowable
     data = ProblemData(
         clients=[Client(x=0, y=1)],
         depots=[Depot(x=0, y=0)],
@@ -416,8 +457,8 @@ def test_matrices_are_not_copies():
         duration_matrix=mat,
     )
 
-    # Ownership is taken, so the memory that's referenced is not that of the
-    # matrices that are passed into ProblemData's constructor.
+    # Writeable arrays are copied, so the memory that's referenced is not that
+    # of the matrices that are passed into ProblemData's constructor.
     assert_(data.distance_matrix().base is not mat)
     assert_(data.duration_matrix().base is not mat)
 
@@ -434,6 +475,182 @@ def test_matrices_are_not_copies():
     assert_(dur1.base is dur2.base)
 
 
+@pytest.mark.parametrize("max_value", [1_000, 100_000, 2**40])
+def test_matrices_use_narrowest_integer_type(max_value: int):
+    """
+    Tests that integer distance and duration matrices are stored using the
+    narrowest integer type that fits all values, without changing the values
+    themselves, or the type of the returned arrays.
+    """
+    mat = np.array([[0, max_value], [-1, 0]])
+    data = ProblemData(
+        clients=[Client(x=0, y=1)],
+        depots=[Depot(x=0, y=0)],
+        vehicle_types=[VehicleType(2, capacity=1)],
+        distance_matrix=mat,
+        duration_matrix=mat,
+    )
+
+    assert_equal(data.distance_matrix(), mat)
+    assert_equal(data.duration_matrix(), mat)
+    assert_equal(data.dist(0, 1), max_value)
+    assert_equal(data.duration(1, 0), -1)
+
+    # Matrices are only narrowed when the extensions use integer precision,
+    # but are always returned as arrays of the full value type.
+    if isinstance(data.dist(0, 1), int):
+        assert_equal(data.distance_matrix().dtype, np.int64)
+        assert_equal(data.duration_matrix().dtype, np.int64)
+
+
+def test_matrices_adopt_read_only_numpy_arrays():
+    """
+    Tests that matrices that cannot be stored more compactly are not copied,
+    but reference the read-only numpy arrays that are passed into ProblemData.
+    """
+    # This matrix is not symmetric, and its values do not fit a narrower
+    # integer type, so it is used as-is.
+    mat = np.array([[0, 2**40], [1, 0]])
+    data = ProblemData(
+        clients=[Client(x=0, y=1)],
+        depots=[Depot(x=0, y=0)],
+        vehicle_types=[VehicleType(2, capacity=1)],
+        distance_matrix=mat,
+        duration_matrix=mat,
+    )
+
+    # Arrays of another type than the matrix elements must be converted
+    # first, so we pass the matrix again in the right type. Only read-only
+    # arrays are adopted, since writeable ones may still be modified.
+    mat = mat.astype(data.distance_matrix().dtype)
+    mat.flags.writeable = False
+    data = data.replace(distance_matrix=mat, duration_matrix=mat)
+
+    assert_(np.shares_memory(data.distance_matrix(), mat))
+    assert_(np.shares_memory(data.duration_matrix(), mat))
+    assert_equal(data.distance_matrix(), mat)
+
+    # The matrices keep the arrays alive while in use.
+    del mat
+    assert_equal(data.dist(0, 1), 2**40)
+    assert_equal(data.dist(1, 0), 1)
+
+
+def test_matrices_copy_writeable_numpy_arrays():
+    """
+    Tests that writeable numpy arrays are copied, so that modifying them after
+    they are passed into ProblemData does not change the instance.
+    """
+    mat = np.array([[0, 2**40], [1, 0]])  # not symmetric, nor narrowable
+    data = ProblemData(
+        clients=[Client(x=0, y=1)],
+        depots=[Depot(x=0, y=0)],
+        vehicle_types=[VehicleType(2, capacity=1)],
+        distance_matrix=mat,
+        duration_matrix=mat,
+    )
+
+    assert_(not np.shares_memory(data.distance_matrix(), mat))
+    assert_(not np.shares_memory(data.duration_matrix(), mat))
+
+    mat[0, 1] = 5
+    assert_equal(data.dist(0, 1), 2**40)
+    assert_equal(data.distance_matrix()[0, 1], 2**40)
+
+
+def test_symmetric_matrices_are_packed():
+    """
+    Tests that symmetric matrices store only their lower triangle. Since there
+    is no full matrix to view, the full matrix is unpacked into a new read-only
+    array on each request, which the instance does not keep.
+    """
+    mat = np.array([[0, 1, 2], [1, 0, 3], [2, 3, 0]])
+    data = ProblemData(
+        clients=[Client(x=0, y=1), Client(x=1, y=0)],
+        depots=[Depot(x=0, y=0)],
+        vehicle_types=[VehicleType(2, capacity=1)],
+        distance_matrix=mat,
+        duration_matrix=mat,
+    )
+
+    for frm in range(data.num_locations):
+        for to in range(data.num_locations):
+            assert_equal(data.dist(frm, to), mat[frm, to])
+            assert_equal(data.duration(frm, to), mat[frm, to])
+
+    dist_mat = data.distance_matrix()
+    assert_equal(dist_mat, mat)
+    assert_(not dist_mat.flags["WRITEABLE"])
+    assert_(not np.shares_memory(dist_mat, data.distance_matrix()))
+
+    # Packed matrices should survive serialisation.
+    loaded = ProblemData.from_bytes(data.to_bytes())
+    assert_equal(loaded.distance_matrix(), mat)
+    assert_equal(loaded.duration_matrix(), mat)
+
+
+def test_relabelling_is_not_visible():
+    """
+    Tests that the internal, spatial relabelling of large instances does not
+    change the distances and durations between locations.
+    """
+    rng = default_rng(seed=42)
+    coords = rng.integers(1000, size=(1_200, 2))
+
+    dist_mat = rng.integers(1, 100, size=(1_200, 1_200))
+    np.fill_diagonal(dist_mat, 0)
+    dur_mat = dist_mat + dist_mat.T  # symmetric, so also packed
+
+    data = ProblemData(
+        clients=[Client(x=x, y=y) for x, y in coords[1:]],
+        depots=[Depot(x=coords[0, 0], y=coords[0, 1])],
+        vehicle_types=[VehicleType(2, capacity=1)],
+        distance_matrix=dist_mat,
+        duration_matrix=dur_mat,
+    )
+
+    for frm, to in rng.integers(1_200, size=(1_000, 2)):
+        assert_equal(data.dist(frm, to), dist_mat[frm, to])
+        assert_equal(data.duration(frm, to), dur_mat[frm, to])
+
+    assert_equal(data.distance_matrix(), dist_mat)
+    assert_equal(data.duration_matrix(), dur_mat)
+
+    # The full matrices are unpacked into temporary arrays on each call, and
+    # are not kept by the instance.
+    dist1, dist2 = data.distance_matrix(), data.distance_matrix()
+    assert_(not np.shares_memory(dist1, dist2))
+
+    # Relabelled matrices should survive serialisation.
+    loaded = ProblemData.from_bytes(data.to_bytes())
+    assert_equal(loaded.distance_matrix(), dist_mat)
+    assert_equal(loaded.duration_matrix(), dur_mat)
+
+
+def test_identical_matrices_share_storage():
+    """
+    Tests that identical distance and duration matrices are stored only once,
+    and that different matrices are not.
+    """
+    mat = np.array([[0, 2**40], [1, 0]])  # stored as-is, so can be viewed
+    data = ProblemData(
+        clients=[Client(x=0, y=1)],
+        depots=[Depot(x=0, y=0)],
+        vehicle_types=[VehicleType(2, capacity=1)],
+        distance_matrix=mat,
+        duration_matrix=mat.copy(),
+    )
+
+    dist_mat = data.distance_matrix()
+    dur_mat = data.duration_matrix()
+    assert_(np.shares_memory(dist_mat, dur_mat))
+
+    other = data.replace(duration_matrix=2 * mat)
+    assert_(not np.shares_memory(other.distance_matrix(), dur_mat))
+    assert_equal(other.distance_matrix(), mat)
+    assert_equal(other.duration_matrix(), 2 * mat)
+
+
 @pytest.mark.parametrize(
     ("capacity", "num_available", "fixed_cost", "tw_early", "tw_late"),
     [
@@ -557,3 +774,366 @@ def test_location_raises_invalid_index(ok_small, idx: int):
 
     with assert_raises(IndexError):
         ok_small.location(idx)
+
+
+def test_problem_data_feature_flags_fixtures(
+    ok_small, small_cvrp, small_spd, prize_collecting
+):
+    """
+    Tests that the instance features used to select specialised evaluation
+    routines are correctly detected on a few benchmark instances.
+    """
+    assert_(ok_small.has_time_windows)
+    assert_(not ok_small.has_optional_clients)
+
+    assert_(not small_cvrp.has_time_windows)
+    assert_(not small_cvrp.has_pickups)
+    assert_(not small_cvrp.has_release_times)
+    assert_(not small_cvrp.has_optional_clients)
+
+    assert_(small_spd.has_pickups)
+    assert_(prize_collecting.has_optional_clients)
+
+
+def test_problem_data_feature_flags():
+    """
+    Tests that each instance feature is detected from the client, depot, and
+    vehicle type data.
+    """
+    data = ProblemData(
+        clients=[Client(x=1, y=1, delivery=1)],
+        depots=[Depot(x=0, y=0)],
+        vehicle_types=[VehicleType(capacity=1)],
+        distance_matrix=np.zeros((2, 2), dtype=int),
+        duration_matrix=np.zeros((2, 2), dtype=int),
+    )
+
+    assert_(not data.has_time_windows)
+    assert_(not data.has_pickups)
+    assert_(not data.has_release_times)
+    assert_(not data.has_optional_clients)
+
+    # A time window that opens, but never closes, cannot result in time warp,
+    # so that does not count as having time windows.
+    data = data.replace(clients=[Client(x=1, y=1, tw_early=5)])
+    assert_(not data.has_time_windows)
+
+    data = data.replace(clients=[Client(x=1, y=1, tw_late=5)])
+    assert_(data.has_time_windows)
+
+    data = data.replace(clients=[Client(x=1, y=1)], depots=[Depot(0, 0, 0, 5)])
+    assert_(data.has_time_windows)
+
+    data = data.replace(
+        depots=[Depot(x=0, y=0)],
+        vehicle_types=[VehicleType(max_duration=5)],
+    )
+    assert_(data.has_time_windows)
+
+    data = data.replace(vehicle_types=[VehicleType(tw_late=5)])
+    assert_(data.has_time_windows)
+
+    data = data.replace(clients=[Client(x=1, y=1, pickup=1)])
+    assert_(data.has_pickups)
+
+    data = data.replace(clients=[Client(x=1, y=1, release_time=1)])
+    assert_(data.has_release_times)
+
+    data = data.replace(clients=[Client(x=1, y=1, required=False)])
+    assert_(data.has_optional_clients)
+
+
+def test_problem_data_to_and_from_bytes(ok_small_multi_depot):
+    """
+    Tests that a problem instance can be converted to and from its binary
+    representation, and that pickling uses this representation.
+    """
+    data = ok_small_multi_depot.replace(
+        vehicle_types=[
+            VehicleType(2, capacity=10, fixed_cost=5, name="first"),
+            VehicleType(1, depot=1, tw_late=20_000, max_duration=10_000),
+        ]
+    )
+
+    data_bytes = data.to_bytes()
+    unpickled = pickle.loads(pickle.dumps(data))
+
+    for other in [ProblemData.from_bytes(data_bytes), unpickled]:
+        assert_equal(other.num_clients, data.num_clients)
+        assert_equal(other.num_depots, data.num_depots)
+        assert_equal(other.num_vehicles, data.num_vehicles)
+        assert_equal(other.distance_matrix(), data.distance_matrix())
+        assert_equal(other.duration_matrix(), data.duration_matrix())
+        assert_equal(other.centroid(), data.centroid())
+        assert_equal(other.to_bytes(), data_bytes)
+
+        for idx in range(data.num_locations):
+            assert_equal(other.location(idx).x, data.location(idx).x)
+            assert_equal(other.location(idx).y, data.location(idx).y)
+            assert_equal(other.location(idx).name, data.location(idx).name)
+
+        for idx in range(data.num_vehicle_types):
+            expected = data.vehicle_type(idx)
+            actual = other.vehicle_type(idx)
+
+            assert_equal(actual.num_available, expected.num_available)
+            assert_equal(actual.capacity, expected.capacity)
+            assert_equal(actual.depot, expected.depot)
+            assert_equal(actual.fixed_cost, expected.fixed_cost)
+            assert_equal(actual.max_duration, expected.max_duration)
+            assert_equal(actual.name, expected.name)
+
+    # Any object that supports the buffer protocol can be used.
+    from_bytearray = ProblemData.from_bytes(bytearray(data_bytes))
+    assert_equal(from_bytearray.to_bytes(), data_bytes)
+
+    from_memoryview = ProblemData.from_bytes(memoryview(data_bytes))
+    assert_equal(from_memoryview.to_bytes(), data_bytes)
+
+
+def test_problem_data_from_bytes_raises_invalid_data(ok_small):
+    """
+    Tests that from_bytes() raises when the given data is truncated, has
+    trailing data, or does not describe a problem instance at all.
+    """
+    data_bytes = ok_small.to_bytes()
+
+    with assert_raises(ValueError):
+        ProblemData.from_bytes(data_bytes[:-1])
+
+    with assert_raises(ValueError):
+        ProblemData.from_bytes(data_bytes + b"\x00")
+
+    with assert_raises(ValueError):
+        ProblemData.from_bytes(b"")
+
+    with assert_raises(ValueError):
+        ProblemData.from_bytes(b"not a problem instance")
+
+
+def test_problem_data_accepts_matrix_files(ok_small, tmp_path):
+    """
+    Tests that paths of matrix files written by write_matrix() can be passed
+    instead of distance and duration matrices.
+    """
+    dist_path = tmp_path / "distance.bin"
+    dur_path = tmp_path / "duration.bin"
+    write_matrix(dist_path, ok_small.distance_matrix())
+    write_matrix(str(dur_path), ok_small.duration_matrix())
+
+    data = ProblemData(
+        clients=ok_small.clients(),
+        depots=ok_small.depots(),
+        vehicle_types=ok_small.vehicle_types(),
+        distance_matrix=dist_path,
+        duration_matrix=str(dur_path),
+    )
+
+    assert_equal(data.distance_matrix(), ok_small.distance_matrix())
+    assert_equal(data.duration_matrix(), ok_small.duration_matrix())
+    assert_equal(data.dist(1, 2), ok_small.dist(1, 2))
+    assert_equal(data.duration(2, 1), ok_small.duration(2, 1))
+
+    # Matrix files can also be used to replace the matrices of an existing
+    # instance. Here we swap the distance and duration matrices.
+    new = ok_small.replace(distance_matrix=dur_path, duration_matrix=dist_path)
+    assert_equal(new.distance_matrix(), ok_small.duration_matrix())
+    assert_equal(new.duration_matrix(), ok_small.distance_matrix())
+
+
+def test_overwriting_matrix_files_keeps_loaded_data(ok_small, tmp_path):
+    """
+    Tests that overwriting a matrix file that is in use by an instance does
+    not change that instance, and leaves no temporary files behind.
+    """
+    path = tmp_path / "distance.bin"
+    write_matrix(path, ok_small.distance_matrix())
+    data = ok_small.replace(distance_matrix=path)
+
+    write_matrix(path, ok_small.duration_matrix())
+    assert_equal(data.distance_matrix(), ok_small.distance_matrix())
+    assert_equal(data.dist(1, 2), ok_small.dist(1, 2))
+
+    new = ok_small.replace(distance_matrix=path)
+    assert_equal(new.distance_matrix(), ok_small.duration_matrix())
+    assert_equal([file.name for file in tmp_path.iterdir()], [path.name])
+
+
+def test_matrix_files_raise_invalid_files(ok_small, tmp_path):
+    """
+    Tests that passing a path to a file that does not exist, or that is not a
+    valid matrix file, raises.
+    """
+    with assert_raises(RuntimeError):
+        ok_small.replace(distance_matrix=tmp_path / "does_not_exist.bin")
+
+    invalid_path = tmp_path / "invalid.bin"
+    invalid_path.write_bytes(b"not a matrix file")
+
+    with assert_raises(ValueError):
+        ok_small.replace(distance_matrix=invalid_path)
+
+    # A valid matrix file that is truncated should also raise.
+    valid_path = tmp_path / "valid.bin"
+    write_matrix(valid_path, ok_small.distance_matrix())
+    invalid_path.write_bytes(valid_path.read_bytes()[:-1])
+
+    with assert_raises(ValueError):
+        ok_small.replace(distance_matrix=invalid_path)
+
+
+def test_instance_files_round_trip(ok_small_multi_depot, tmp_path):
+    """
+    Tests that instances written by write_instance_file() are read again by
+    read_instance_file(), together with their neighbours, if any.
+    """
+    data = ok_small_multi_depot.replace(
+        vehicle_types=[
+            VehicleType(2, capacity=10, fixed_cost=5, name="first"),
+            VehicleType(1, depot=1, tw_late=20_000, max_duration=10_000),
+        ]
+    )
+
+    neighbours = [[], [], [3, 4], [2], [2, 3]]
+    write_instance_file(tmp_path / "with.pyvrp", data, neighbours)
+    write_instance_file(str(tmp_path / "without.pyvrp"), data)
+
+    loaded, loaded_neighbours = read_instance_file(tmp_path / "with.pyvrp")
+    assert_equal(loaded_neighbours, neighbours)
+    assert_equal(loaded.to_bytes(), data.to_bytes())
+    assert_equal(loaded.distance_matrix(), data.distance_matrix())
+    assert_equal(loaded.duration_matrix(), data.duration_matrix())
+
+    loaded, loaded_neighbours = read_instance_file(tmp_path / "without.pyvrp")
+    assert_(loaded_neighbours is None)
+    assert_equal(loaded.to_bytes(), data.to_bytes())
+
+    # Instances with matrices computed by a metric are stored as their metric.
+    data = data.replace(distance_matrix=Metric(), duration_matrix=Metric())
+    write_instance_file(tmp_path / "metric.pyvrp", data)
+
+    loaded, _ = read_instance_file(tmp_path / "metric.pyvrp")
+    assert_equal(loaded.to_bytes(), data.to_bytes())
+    assert_equal(loaded.distance_matrix(), data.distance_matrix())
+
+
+def test_instance_files_raise_invalid_arguments(ok_small, tmp_path):
+    """
+    Tests that writing an instance file raises when the neighbours do not
+    match the instance, and that reading one raises when the file does not
+    exist, or is not a valid instance file.
+    """
+    path = tmp_path / "instance.pyvrp"
+
+    with assert_raises(ValueError):  # not neighbours for each location
+        write_instance_file(path, ok_small, [[1], [2]])
+
+    with assert_raises(ValueError):  # location 5 does not exist
+        write_instance_file(path, ok_small, [[], [5], [], [], []])
+
+    with assert_raises(RuntimeError):
+        read_instance_file(tmp_path / "does_not_exist.pyvrp")
+
+    path.write_bytes(b"not an instance file")
+    with assert_raises(ValueError):
+        read_instance_file(path)
+
+    # A valid instance file that is truncated should also raise.
+    write_instance_file(path, ok_small)
+    path.write_bytes(path.read_bytes()[:-64])
+
+    with assert_raises(ValueError):
+        read_instance_file(path)
+
+
+def test_overwriting_instance_files_keeps_loaded_data(ok_small, tmp_path):
+    """
+    Tests that overwriting an instance file that is in use does not change
+    the instance read from it, and leaves no temporary files behind.
+    """
+    path = tmp_path / "instance.pyvrp"
+    write_instance_file(path, ok_small)
+    data, _ = read_instance_file(path)
+
+    other = ok_small.replace(distance_matrix=ok_small.duration_matrix())
+    write_instance_file(path, other)
+    assert_equal(data.distance_matrix(), ok_small.distance_matrix())
+    assert_equal(data.to_bytes(), ok_small.to_bytes())
+
+    loaded, _ = read_instance_file(path)
+    assert_equal(loaded.distance_matrix(), other.distance_matrix())
+    assert_equal([file.name for file in tmp_path.iterdir()], [path.name])
+
+
+def test_metric_computes_matrices_from_coordinates(ok_small):
+    """
+    Tests that metrics passed in place of matrices compute the distances and
+    durations from the coordinates of the depots and clients.
+    """
+    data = ok_small.replace(
+        distance_matrix=Metric(),
+        duration_matrix=Metric("euclidean", scale=0.5),
+    )
+
+    locs = data.depots() + data.clients()
+    coords = np.array([[loc.x, loc.y] for loc in locs])
+    dists = np.linalg.norm(coords[:, None] - coords[None, :], axis=-1)
+
+    # The computed values are rounded to the nearest integer, with halves
+    # rounded up.
+    assert_equal(data.distance_matrix(), np.floor(dists + 0.5))
+    assert_equal(data.duration_matrix(), np.floor(0.5 * dists + 0.5))
+    assert_equal(data.dist(1, 2), np.floor(dists[1, 2] + 0.5))
+
+    # The metrics are bound to the new coordinates when clients are replaced.
+    clients = [Client(x=0, y=3), Client(x=4, y=0), *data.clients()[2:]]
+    new = data.replace(clients=clients)
+    assert_equal(new.dist(1, 2), 5)
+    assert_equal(new.duration(1, 2), 3)
+
+    # Metrics are kept when the instance is serialised.
+    loaded = pickle.loads(pickle.dumps(new))
+    assert_equal(loaded.distance_matrix(), new.distance_matrix())
+    assert_equal(loaded.duration_matrix(), new.duration_matrix())
+
+
+def test_haversine_metric():
+    """
+    Tests that the haversine metric computes great-circle distances in metres,
+    with x as the longitude and y as the latitude.
+    """
+    for degrees_per_unit, unit in [(1, 1), (1e-6, 1_000_000)]:
+        data = ProblemData(
+            clients=[Client(x=unit, y=0), Client(x=0, y=unit)],
+            depots=[Depot(x=0, y=0)],
+            vehicle_types=[VehicleType()],
+            distance_matrix=Metric("haversine", 1, degrees_per_unit),
+            duration_matrix=Metric("haversine", 0.1, degrees_per_unit),
+        )
+
+        # One degree along the equator or along a meridian is about 111.2km,
+        # and the great-circle distance between both clients is 157.2km.
+        assert_equal(data.dist(0, 1), 111_195)
+        assert_equal(data.dist(0, 2), 111_195)
+        assert_equal(data.dist(1, 2), 157_250)
+        assert_equal(data.duration(0, 1), 11_120)
+
+
+def test_metric_raises_invalid_arguments():
+    """
+    Tests that metrics raise when their kind is not understood, or when their
+    scale arguments are not positive.
+    """
+    with assert_raises(ValueError):
+        Metric("manhattan")
+
+    with assert_raises(ValueError):
+        Metric("euclidean", scale=0)
+
+    with assert_raises(ValueError):
+        Metric("haversine", degrees_per_unit=-1)
+
+    metric = Metric("haversine", scale=2, degrees_per_unit=0.5)
+    assert_equal(metric.kind, "haversine")
+    assert_equal(metric.scale, 2)
+    assert_equal(metric.degrees_per_unit, 0.5)
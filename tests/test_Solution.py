@@ -1,4 +1,5 @@
 import pickle
+import sys
 from copy import copy, deepcopy
 
 import numpy as np
@@ -93,6 +94,26 @@ def test_route_eq(ok_small):
     assert_(route1 != -1.0)
 
 
+def test_routes_with_same_visits_in_different_instances(ok_small):
+    """
+    Tests that identical routes may share their data, but routes visiting the
+    same clients in different instances still have their own statistics.
+    """
+    route1 = Route(ok_small, [1, 2], 0)
+    route2 = Route(ok_small, [1, 2], 0)
+    assert_equal(route1, route2)
+    assert_equal(route1.distance(), route2.distance())
+
+    data = ok_small.replace(distance_matrix=2 * ok_small.distance_matrix())
+    route3 = Route(data, [1, 2], 0)
+    assert_equal(route3.visits(), route1.visits())
+    assert_equal(route3.distance(), 2 * route1.distance())
+    assert_(route3 != route1)
+
+    # The original route's statistics are unaffected by the new route.
+    assert_equal(Route(ok_small, [1, 2], 0).distance(), route1.distance())
+
+
 def test_random_constructor_cycles_over_routes(ok_small):
     """
     Tests that a randomly constructed solution fills all available vehicles
@@ -715,6 +736,26 @@ def test_copy(ok_small):
     assert_(sol is not deepcopy_sol)
 
 
+def test_routes_outlive_solution(ok_small):
+    """
+    Tests that routes share their data with the solution they were obtained
+    from, but remain valid after that solution has been deleted.
+    """
+    sol = Solution(ok_small, [[1, 2], [3, 4]])
+    copy_sol = copy(sol)
+    routes = sol.get_routes()
+
+    del sol
+    assert_equal(routes, copy_sol.get_routes())
+    assert_equal(routes[0].visits(), [1, 2])
+    assert_equal(routes[1].visits(), [3, 4])
+
+    # Routes built from the same visits compare equal to the retained routes.
+    sol = Solution(ok_small, routes)
+    assert_equal(sol, copy_sol)
+    assert_equal(sol.get_neighbours(), copy_sol.get_neighbours())
+
+
 def test_eq(ok_small):
     """
     Tests the solution's equality operator.
@@ -773,6 +814,22 @@ def test_eq_with_multiple_vehicle_types(ok_small):
     sol3 = Solution(data, [Route(data, [1, 2], 1), Route(data, [3, 4], 0)])
     assert_(sol1 != sol3)
 
+    # Routes are matched regardless of their position, also when the routes
+    # have been rotated rather than swapped.
+    routes = [
+        Route(data, [1], 0),
+        Route(data, [2, 3], 0),
+        Route(data, [4], 1),
+    ]
+
+    sol1 = Solution(data, routes)
+    sol2 = Solution(data, routes[1:] + routes[:1])
+    assert_(sol1 == sol2)
+
+    routes[1], routes[2] = Route(data, [2, 3], 1), Route(data, [4], 0)
+    sol3 = Solution(data, routes[2:] + routes[:2])
+    assert_(sol1 != sol3)
+
 
 def test_eq_unassigned():
     """
@@ -864,6 +921,34 @@ def test_hash(ok_small):
     assert_equal(hash(sol2), hash(sol3))
 
 
+def test_hash_is_structural(ok_small):
+    """
+    Tests that the hash depends only on the solution's structure: not on the
+    order of the routes, but on their visits and vehicle types.
+    """
+    data = ok_small.replace(
+        vehicle_types=[VehicleType(capacity=10), VehicleType(2, capacity=20)]
+    )
+
+    sol1 = Solution(data, [Route(data, [1, 2], 0), Route(data, [3, 4], 1)])
+    sol2 = Solution(data, [Route(data, [3, 4], 1), Route(data, [1, 2], 0)])
+
+    # Same routes, but in a different order. These solutions are the same, and
+    # should thus also have the same hash.
+    assert_equal(sol1, sol2)
+    assert_equal(hash(sol1), hash(sol2))
+
+    # Swapping the vehicle types changes the solution, and thus also the hash.
+    sol3 = Solution(data, [Route(data, [1, 2], 1), Route(data, [3, 4], 0)])
+    assert_(sol1 != sol3)
+    assert_(hash(sol1) != hash(sol3))
+
+    # As does reversing one of the routes.
+    sol4 = Solution(data, [Route(data, [2, 1], 0), Route(data, [3, 4], 1)])
+    assert_(sol1 != sol4)
+    assert_(hash(sol1) != hash(sol4))
+
+
 def test_route_centroid(ok_small):
     """
     Tests that each route's center point is the center point of all clients
@@ -911,6 +996,67 @@ def test_route_can_be_pickled(rc208):
         assert_equal(after_pickle, before_pickle)
 
 
+def test_solution_to_and_from_bytes(rc208):
+    """
+    Tests that solutions and routes can be converted to and from their binary
+    representation, and that all their statistics are preserved.
+    """
+    rng = RandomNumberGenerator(seed=2)
+    sol = Solution.make_random(rc208, rng)
+
+    from_bytes = Solution.from_bytes(sol.to_bytes())
+    assert_equal(from_bytes, sol)
+    assert_equal(hash(from_bytes), hash(sol))
+    assert_equal(from_bytes.get_neighbours(), sol.get_neighbours())
+    assert_equal(from_bytes.num_missing_clients(), sol.num_missing_clients())
+    assert_equal(from_bytes.fixed_vehicle_cost(), sol.fixed_vehicle_cost())
+    assert_equal(from_bytes.uncollected_prizes(), sol.uncollected_prizes())
+
+    for route in sol.get_routes():
+        route_from_bytes = Route.from_bytes(route.to_bytes())
+        assert_equal(route_from_bytes, route)
+        assert_equal(route_from_bytes.wait_duration(), route.wait_duration())
+        assert_equal(route_from_bytes.slack(), route.slack())
+        assert_equal(route_from_bytes.centroid(), route.centroid())
+        assert_equal(route_from_bytes.depot(), route.depot())
+
+
+def test_solution_from_bytes_raises_invalid_data(ok_small):
+    """
+    Tests that Solution.from_bytes() and Route.from_bytes() raise when the
+    given data is truncated, or describes another kind of object.
+    """
+    sol = Solution(ok_small, [[1, 2], [3, 4]])
+    sol_bytes = sol.to_bytes()
+    route_bytes = sol.get_routes()[0].to_bytes()
+
+    with assert_raises(ValueError):
+        Solution.from_bytes(sol_bytes[:-1])
+
+    with assert_raises(ValueError):
+        Route.from_bytes(route_bytes[:-1])
+
+    with assert_raises(ValueError):  # route data does not describe a solution
+        Solution.from_bytes(route_bytes)
+
+    with assert_raises(ValueError):  # and solution data is not a route
+        Route.from_bytes(sol_bytes)
+
+    # The number of locations is stored after the header (tag, version, and
+    # value type), two counts, and six measures. Claiming a huge number of
+    # locations should raise rather than attempt to allocate for them.
+    offset = 4 + 4 + 1 + 2 * 8 + 6 * 8
+    huge = (2**62).to_bytes(8, sys.byteorder)
+    invalid = sol_bytes[:offset] + huge + sol_bytes[offset + 8 :]
+    with assert_raises(ValueError):
+        Solution.from_bytes(invalid)
+
+    # Buffers that are not contiguous cannot be read as a single block.
+    padded = bytes(byte for value in sol_bytes for byte in (value, 0))
+    with assert_raises(ValueError):
+        Solution.from_bytes(memoryview(padded)[::2])
+
+
 @mark.parametrize(
     ("assignment", "expected"), [((0, 0), 0), ((0, 1), 10), ((1, 1), 20)]
 )
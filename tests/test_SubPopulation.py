@@ -1,5 +1,5 @@
 import numpy as np
-from numpy.testing import assert_, assert_allclose, assert_equal
+from numpy.testing import assert_, assert_allclose, assert_equal, assert_raises
 from pytest import mark
 
 from pyvrp import (
@@ -8,7 +8,7 @@ from pyvrp import (
     RandomNumberGenerator,
     Solution,
 )
-from pyvrp._pyvrp import SubPopulation
+from pyvrp._pyvrp import SubPopulation, select_parents
 from pyvrp.diversity import broken_pairs_distance as bpd
 
 
@@ -160,3 +160,206 @@ def test_fitness_is_average_of_cost_and_diversity_when_no_elites(rc208):
     # agree with what we've computed above.
     assert_(((actual_fitness >= 0) & (actual_fitness <= 1)).all())
     assert_allclose(actual_fitness, expected_fitness)
+
+
+@mark.parametrize("nb_close", [1, 5, 10])
+def test_avg_distance_closest_after_purging(rc208, nb_close: int):
+    """
+    Tests that the average distance to the closest solutions remains correct
+    after solutions have been added and purged from the subpopulation a number
+    of times.
+    """
+    cost_evaluator = CostEvaluator(20, 6)
+    rng = RandomNumberGenerator(seed=42)
+    params = PopulationParams(
+        min_pop_size=10, generation_size=5, nb_close=nb_close
+    )
+    subpop = SubPopulation(bpd, params)
+
+    # This triggers several purges, which remove solutions from (and thus
+    # reuse storage within) the subpopulation.
+    for _ in range(50):
+        subpop.add(Solution.make_random(rc208, rng), cost_evaluator)
+
+    assert_(len(subpop) <= params.max_pop_size)
+
+    for idx, item in enumerate(subpop):
+        dists = [
+            bpd(item.solution, other.solution)
+            for other_idx, other in enumerate(subpop)
+            if other_idx != idx
+        ]
+
+        expected = np.mean(np.sort(dists)[:nb_close])
+        assert_allclose(item.avg_distance_closest(), expected)
+
+
+@mark.parametrize("num_threads", [2, 3, 8])
+def test_parallel_distances_match_serial(rc208, num_threads: int):
+    """
+    Tests that distances computed in parallel, which happens for large enough
+    workloads, are the same as those computed serially. The threshold is set
+    to zero here to ensure every distance computation uses multiple threads.
+    """
+    cost_evaluator = CostEvaluator(20, 6)
+    rng = RandomNumberGenerator(seed=42)
+    sols = [Solution.make_random(rc208, rng) for _ in range(50)]
+
+    serial_params = PopulationParams(min_pop_size=10, generation_size=5)
+    parallel_params = PopulationParams(
+        min_pop_size=10,
+        generation_size=5,
+        num_threads=num_threads,
+        parallel_threshold=0,
+    )
+
+    serial = SubPopulation(bpd, serial_params)
+    parallel = SubPopulation(bpd, parallel_params)
+
+    # Adding this many solutions triggers several purges, which also depend
+    # on the distances.
+    for sol in sols:
+        serial.add(sol, cost_evaluator)
+        parallel.add(sol, cost_evaluator)
+
+    assert_equal(len(parallel), len(serial))
+    for serial_item, parallel_item in zip(serial, parallel):
+        assert_(parallel_item.solution == serial_item.solution)
+        assert_equal(
+            parallel_item.avg_distance_closest(),
+            serial_item.avg_distance_closest(),
+        )
+
+
+def test_fitness_is_updated_when_penalties_change(rc208):
+    """
+    Tests that the fitness values are recomputed when update_fitness is called
+    with a cost evaluator using different penalty values, also when the
+    subpopulation itself did not change in the meantime.
+    """
+    rng = RandomNumberGenerator(seed=53)
+    params = PopulationParams(min_pop_size=25)
+    solutions = [Solution.make_random(rc208, rng) for _ in range(25)]
+
+    subpop1 = SubPopulation(bpd, params)
+    subpop2 = SubPopulation(bpd, params)
+
+    for sol in solutions:
+        subpop1.add(sol, CostEvaluator(20, 6))
+        subpop2.add(sol, CostEvaluator(20, 6))
+
+    # First update the first subpopulation using one set of penalties, and
+    # then using another set of penalties. The second subpopulation is only
+    # ever updated using the second set of penalties.
+    subpop1.update_fitness(CostEvaluator(20, 6))
+    subpop1.update_fitness(CostEvaluator(1, 100))
+    subpop2.update_fitness(CostEvaluator(1, 100))
+
+    # The fitness values should now agree, since only the last update matters.
+    fitness1 = [item.fitness for item in subpop1]
+    fitness2 = [item.fitness for item in subpop2]
+    assert_allclose(fitness1, fitness2)
+
+
+def test_solutions_are_intact_after_purging(rc208):
+    """
+    Tests that the solutions in the subpopulation remain equal to the solutions
+    that were added, also after purging, when the subpopulation starts reusing
+    the memory of previously removed solutions.
+    """
+    cost_evaluator = CostEvaluator(20, 6)
+    rng = RandomNumberGenerator(seed=54)
+    params = PopulationParams(min_pop_size=5, generation_size=5)
+    subpop = SubPopulation(bpd, params)
+
+    added = []
+    for _ in range(50):
+        sol = Solution.make_random(rc208, rng)
+        subpop.add(sol, cost_evaluator)
+        added.append(sol)
+
+        # Each solution in the subpopulation must be one of the solutions that
+        # was added to it, with the same routes.
+        for item in subpop:
+            assert_(any(item.solution == other for other in added))
+
+
+def test_select_parents_raises_empty_or_zero_k(rc208):
+    """
+    Tests that select_parents() raises when the population is empty, or when
+    the tournament size k is zero.
+    """
+    cost_evaluator = CostEvaluator(20, 6)
+    rng = RandomNumberGenerator(seed=55)
+    params = PopulationParams()
+
+    feas = SubPopulation(bpd, params)
+    infeas = SubPopulation(bpd, params)
+
+    with assert_raises(RuntimeError):
+        select_parents(feas, infeas, rng)
+
+    infeas.add(Solution.make_random(rc208, rng), cost_evaluator)
+    infeas.update_fitness(cost_evaluator)
+
+    with assert_raises(ValueError):
+        select_parents(feas, infeas, rng, k=0)
+
+    # With a single solution, we can only return that solution as both parents.
+    first, second = select_parents(feas, infeas, rng)
+    assert_equal(first, infeas[0].solution)
+    assert_equal(second, infeas[0].solution)
+
+
+def test_select_parents_large_tournament_returns_fittest(rc208):
+    """
+    Tests that the first parent is the fittest solution when the tournament
+    size is very large, since then every solution is almost surely drawn.
+    """
+    cost_evaluator = CostEvaluator(20, 6)
+    rng = RandomNumberGenerator(seed=56)
+    params = PopulationParams()
+
+    feas = SubPopulation(bpd, params)
+    infeas = SubPopulation(bpd, params)
+
+    for _ in range(10):
+        infeas.add(Solution.make_random(rc208, rng), cost_evaluator)
+
+    infeas.update_fitness(cost_evaluator)
+    best_fitness = min(item.fitness for item in infeas)
+
+    first, _ = select_parents(feas, infeas, rng, k=1_000)
+    first_item = next(item for item in infeas if item.solution == first)
+    assert_allclose(first_item.fitness, best_fitness)
+
+
+def test_select_parents_outlive_subpopulations(rc208):
+    """
+    Tests that the selected parents remain valid after the subpopulations they
+    were selected from purge their solutions, or are deleted altogether.
+    """
+    cost_evaluator = CostEvaluator(20, 6)
+    rng = RandomNumberGenerator(seed=42)
+    params = PopulationParams(min_pop_size=5, generation_size=5)
+
+    feas = SubPopulation(bpd, params)
+    infeas = SubPopulation(bpd, params)
+
+    for _ in range(5):
+        infeas.add(Solution.make_random(rc208, rng), cost_evaluator)
+
+    infeas.update_fitness(cost_evaluator)
+    first, second = select_parents(feas, infeas, rng)
+    first_routes = [route.visits() for route in first.get_routes()]
+    second_routes = [route.visits() for route in second.get_routes()]
+
+    # Adding this many solutions triggers several purges, which reuse the
+    # memory of the purged solutions for the newly added ones.
+    for _ in range(50):
+        infeas.add(Solution.make_random(rc208, rng), cost_evaluator)
+
+    del feas, infeas
+
+    for parent, routes in [(first, first_routes), (second, second_routes)]:
+        assert_equal([route.visits() for route in parent.get_routes()], routes)
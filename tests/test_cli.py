@@ -0,0 +1,110 @@
+import pathlib
+import shutil
+from typing import Optional
+
+import pytest
+from numpy.testing import assert_, assert_equal
+
+import pyvrp.cli
+from pyvrp.cli import load_instance
+from pyvrp.search import NeighbourhoodParams, compute_neighbours
+
+DATA_DIR = pathlib.Path(__file__).parent / "data"
+
+
+@pytest.fixture
+def instance_loc(tmp_path):
+    """
+    Fixture that returns the location of a copy of the OkSmall instance, which
+    tests can freely modify.
+    """
+    loc = tmp_path / "instances" / "OkSmall.txt"
+    loc.parent.mkdir()
+    shutil.copy(DATA_DIR / "OkSmall.txt", loc)
+    return loc
+
+
+def load(loc: pathlib.Path, cache_dir: Optional[pathlib.Path]):
+    nb_params = NeighbourhoodParams()
+    return load_instance(loc, "vrplib", "none", nb_params, cache_dir)
+
+
+def test_load_instance_without_cache(instance_loc):
+    """
+    Tests that load_instance() reads the instance, and computes its
+    neighbourhood, when no cache directory is given.
+    """
+    data, neighbours = load(instance_loc, None)
+    assert_equal(data.num_clients, 4)
+    assert_equal(neighbours, compute_neighbours(data, NeighbourhoodParams()))
+
+
+def test_load_instance_cache_hit(instance_loc, tmp_path, monkeypatch):
+    """
+    Tests that a second call loads the instance and its neighbourhood from
+    the cache, without reading the instance again.
+    """
+    cache_dir = tmp_path / "cache"
+    data, neighbours = load(instance_loc, cache_dir)
+    assert_equal(len(list(cache_dir.iterdir())), 1)
+
+    def fail(*args, **kwargs):
+        raise AssertionError("The instance should not be read again.")
+
+    monkeypatch.setattr(pyvrp.cli, "read", fail)
+    cached_data, cached_neighbours = load(instance_loc, cache_dir)
+
+    assert_equal(cached_data.to_bytes(), data.to_bytes())
+    assert_equal(cached_neighbours, neighbours)
+
+
+def test_load_instance_stale_cache(instance_loc, tmp_path):
+    """
+    Tests that the cache is not used after the instance file is modified, or
+    for an instance with the same name in another directory.
+    """
+    cache_dir = tmp_path / "cache"
+    data, _ = load(instance_loc, cache_dir)
+
+    # Change the capacity of the vehicles. The modified instance should be
+    # read again, and not be loaded from the cache.
+    text = instance_loc.read_text()
+    instance_loc.write_text(text.replace("CAPACITY : 10", "CAPACITY : 100"))
+
+    new_data, _ = load(instance_loc, cache_dir)
+    assert_equal(data.vehicle_type(0).capacity, 10)
+    assert_equal(new_data.vehicle_type(0).capacity, 100)
+    assert_equal(len(list(cache_dir.iterdir())), 2)
+
+    # An instance with the same name elsewhere gets its own cache file.
+    other_loc = tmp_path / "other" / instance_loc.name
+    other_loc.parent.mkdir()
+    shutil.copy(DATA_DIR / "OkSmall.txt", other_loc)
+
+    other_data, _ = load(other_loc, cache_dir)
+    assert_equal(other_data.vehicle_type(0).capacity, 10)
+    assert_equal(len(list(cache_dir.iterdir())), 3)
+
+
+def test_load_instance_corrupt_cache(instance_loc, tmp_path):
+    """
+    Tests that a corrupt cache file is ignored, and replaced by a valid one.
+    """
+    cache_dir = tmp_path / "cache"
+    data, neighbours = load(instance_loc, cache_dir)
+
+    (cache_loc,) = cache_dir.iterdir()
+    cache_loc.write_bytes(b"not an instance file")
+
+    loaded_data, loaded_neighbours = load(instance_loc, cache_dir)
+    assert_equal(loaded_data.to_bytes(), data.to_bytes())
+    assert_equal(loaded_neighbours, neighbours)
+
+    # The corrupt file has been replaced by a valid cache file, which is not
+    # truncated either.
+    assert_equal([loc.name for loc in cache_dir.iterdir()], [cache_loc.name])
+    assert_(cache_loc.read_bytes() != b"not an instance file")
+
+    cache_loc.write_bytes(cache_loc.read_bytes()[:-64])
+    loaded_data, _ = load(instance_loc, cache_dir)
+    assert_equal(loaded_data.to_bytes(), data.to_bytes())
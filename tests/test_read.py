@@ -1,6 +1,8 @@
+import pathlib
 from math import sqrt
 
 import numpy as np
+import vrplib
 from numpy.testing import (
     assert_,
     assert_allclose,
@@ -10,8 +12,10 @@ from numpy.testing import (
 )
 from pytest import mark
 
+from pyvrp._pyvrp import UnsupportedInstanceError, read_instance
 from pyvrp.constants import MAX_VALUE
 from pyvrp.exceptions import ScalingWarning
+from pyvrp.read import ROUND_FUNCS
 from tests.helpers import read
 
 
@@ -437,3 +441,177 @@ def test_vrpb_instance():
             else:
                 assert_(data.dist(frm, to) < MAX_VALUE)
                 assert_(data.duration(frm, to) < MAX_VALUE)
+
+
+@mark.parametrize(
+    ("where", "instance_format", "round_func"),
+    [
+        ("data/OkSmall.txt", "vrplib", "none"),
+        ("data/OkSmallMultipleDepots.txt", "vrplib", "none"),
+        ("data/OkSmallPrizes.txt", "vrplib", "none"),
+        ("data/ServiceTimeSpecification.txt", "vrplib", "none"),
+        ("data/E-n22-k4.txt", "vrplib", "trunc1"),
+        ("data/PR11A.vrp", "vrplib", "trunc"),
+        ("data/SmallVRPSPD.vrp", "vrplib", "round"),
+        ("data/RC208.txt", "solomon", "round"),
+        ("data/RC208.txt", "solomon", "dimacs"),
+    ],
+)
+def test_read_instance_same_as_vrplib(
+    where: str, instance_format: str, round_func: str
+):
+    """
+    Tests that the native reader returns the same data as reading the instance
+    through the vrplib package, which ``read()`` does when it is given a
+    rounding function rather than its name.
+    """
+    path = pathlib.Path(__file__).parent / where
+    native = read_instance(path, instance_format, round_func)
+    data = read(where, instance_format, ROUND_FUNCS[round_func])
+
+    assert_equal(native.num_depots, data.num_depots)
+    assert_equal(native.num_clients, data.num_clients)
+    assert_equal(native.num_vehicle_types, data.num_vehicle_types)
+
+    assert_equal(native.distance_matrix(), data.distance_matrix())
+    assert_equal(native.duration_matrix(), data.duration_matrix())
+
+    for ours, theirs in zip(native.depots(), data.depots()):
+        for attr in ["x", "y", "tw_early", "tw_late"]:
+            assert_equal(getattr(ours, attr), getattr(theirs, attr))
+
+    client_attrs = [
+        "x",
+        "y",
+        "delivery",
+        "pickup",
+        "service_duration",
+        "tw_early",
+        "tw_late",
+        "release_time",
+        "prize",
+        "required",
+    ]
+
+    for ours, theirs in zip(native.clients(), data.clients()):
+        for attr in client_attrs:
+            assert_equal(getattr(ours, attr), getattr(theirs, attr))
+
+    type_attrs = ["num_available", "capacity", "depot", "max_duration", "name"]
+    for ours, theirs in zip(native.vehicle_types(), data.vehicle_types()):
+        for attr in type_attrs:
+            assert_equal(getattr(ours, attr), getattr(theirs, attr))
+
+
+@mark.parametrize(
+    "where",
+    [
+        "data/X-n101-50-k13.vrp",  # VRPB needs adjusted edge weights
+        "data/ReallyLargeDistance.txt",  # should warn about scaling issues
+        "data/FileWithUnknownSection.txt",
+        "data/UnknownEdgeWeightFmt.txt",
+        "somewhere that does not exist",
+    ],
+)
+def test_read_instance_raises_unsupported(where: str):
+    """
+    Tests that the native reader raises an UnsupportedInstanceError for files
+    it does not support. ``read()`` then falls back to reading the file
+    through vrplib.
+    """
+    with assert_raises(UnsupportedInstanceError):
+        read_instance(pathlib.Path(__file__).parent / where)
+
+
+def test_read_does_not_fall_back_for_invalid_instances(monkeypatch):
+    """
+    Tests that ``read()`` raises the native reader's error for instances it
+    does support, but that are not valid, rather than reading such instances
+    again through vrplib.
+    """
+    where = "data/TimeWindowOpenLargerThanClose.txt"
+    with assert_raises(ValueError) as error:
+        read_instance(pathlib.Path(__file__).parent / where)
+
+    assert_(not isinstance(error.exception, UnsupportedInstanceError))
+
+    def fail(*args, **kwargs):
+        raise AssertionError("The instance should not be read again.")
+
+    monkeypatch.setattr(vrplib, "read_instance", fail)
+    with assert_raises(ValueError):
+        read(where)
+
+
+
+def test_read_instance_matches_section_headers_exactly(tmp_path):
+    """
+    Tests that the native reader only treats lines that are exactly ``EOF``,
+    or that start with a ``<NAME>_SECTION`` header, as the end of the file or
+    the start of a section, and not every line that mentions these.
+    """
+    text = (pathlib.Path(__file__).parent / "data/OkSmall.txt").read_text()
+    text = text.replace(
+        "COMMENT : Small problem instance with four customers",
+        "COMMENT : Not an EOF, nor a SECTION",
+    )
+
+    path = tmp_path / "OkSmall.txt"
+    path.write_text(text)
+
+    data = read_instance(path)
+    assert_equal(data.num_clients, 4)
+    assert_equal(data.num_vehicles, 3)
+    assert_equal(data.location(1).service_duration, 360)
+
+
+@mark.parametrize("edge_weight_type", ["EUC_2D", "EXPLICIT"])
+def test_read_instance_large_edge_weights_same_as_vrplib(
+    tmp_path, edge_weight_type: str
+):
+    """
+    Tests that the native reader computes the same edge weights as vrplib for
+    instances large enough for the weights to be computed on multiple threads,
+    and that it raises when any of the rows of weights is invalid.
+    """
+    rng = np.random.default_rng(seed=1)
+    dim = 600
+    coords = rng.integers(1000, size=(dim, 2))
+    weights = rng.integers(1000, size=(dim, dim))
+    np.fill_diagonal(weights, 0)
+
+    def write(rows: list[str]) -> pathlib.Path:
+        lines = [
+            "NAME : LARGE",
+            f"DIMENSION : {dim}",
+            f"EDGE_WEIGHT_TYPE : {edge_weight_type}",
+            "EDGE_WEIGHT_FORMAT : FULL_MATRIX",
+            "CAPACITY : 10",
+            "NODE_COORD_SECTION",
+            *[f"{idx + 1} {x} {y}" for idx, (x, y) in enumerate(coords)],
+            "DEMAND_SECTION",
+            *[f"{idx + 1} {int(idx > 0)}" for idx in range(dim)],
+            "DEPOT_SECTION",
+            "1",
+            "-1",
+        ]
+
+        if edge_weight_type == "EXPLICIT":
+            lines += ["EDGE_WEIGHT_SECTION", *rows]
+
+        path = tmp_path / "large.vrp"
+        path.write_text("\n".join([*lines, "EOF"]))
+        return path
+
+    rows = [" ".join(map(str, row)) for row in weights]
+    path = write(rows)
+
+    native = read_instance(path, "vrplib", "round")
+    data = read(path, "vrplib", ROUND_FUNCS["round"])
+    assert_equal(native.distance_matrix(), data.distance_matrix())
+    assert_equal(native.duration_matrix(), data.duration_matrix())
+
+    if edge_weight_type == "EXPLICIT":
+        rows[-1] += " 1"  # the last row now has too many weights
+        with assert_raises(UnsupportedInstanceError):
+            read_instance(write(rows), "vrplib", "round")